@@ -0,0 +1,71 @@
+#include "arena.h"
+#include "scheduler.h"
+#include "log.h"
+#include "util.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nb::memory::Arena;
+
+int main()
+{
+    // pmr 容器直接使用 Arena，小分配来自块池，大分配单独申请
+    {
+        Arena arena;
+        std::pmr::vector<std::pmr::string> strings(&arena);
+        for (int i = 0; i < 1000; ++i) {
+            strings.emplace_back(std::string(100, static_cast<char>('a' + i % 26)));
+        }
+        for (int i = 0; i < 1000; ++i) {
+            NB_ASSERT(strings[i].size() == 100 && strings[i][0] == 'a' + i % 26, "pmr string content mismatch");
+        }
+        void* aligned = arena.allocate(64, 64);
+        NB_ASSERT(reinterpret_cast<uintptr_t>(aligned) % 64 == 0, "alignment not honored");
+        NB_ASSERT(arena.used() > 100 * 1000, "used() too small");
+        size_t used = arena.used();
+        strings = std::pmr::vector<std::pmr::string>(&arena);
+        arena.reset();
+        NB_ASSERT(arena.used() == 0 && arena.highWater() == used, "reset() should keep the high-water mark");
+    }
+
+    // 协程内的分配在协程结束时整体释放，块回到线程缓存中
+    nb::scheduler::Scheduler scheduler(2, "arena");
+    scheduler.start();
+    std::atomic<int> done {0};
+    for (int i = 0; i < 100; ++i) {
+        scheduler.schedule([&done, i]() {
+            std::pmr::memory_resource* resource = nb::coroutine::Coroutine::GetArena();
+            NB_ASSERT(resource != std::pmr::get_default_resource(), "coroutine should have an arena");
+            std::pmr::string text(resource);
+            for (int j = 0; j < 100 + i * 10; ++j) {
+                text.append("request data ");
+                if (j % 50 == 0) {
+                    nb::coroutine::Coroutine::Yield();
+                }
+            }
+            done++;
+        });
+    }
+    while (done < 100) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    scheduler.stop();
+    NB_ASSERT(nb::coroutine::Coroutine::GetArena() == std::pmr::get_default_resource(),
+              "no arena outside coroutines");
+
+    auto stats = Arena::GetStats();
+    NB_ASSERT(stats.resets >= 101, "each coroutine should reset its arena");
+    NB_LOG_INFO("Arena test passed, resets {} chunks {} large {} peak {} mean {}",
+                stats.resets, stats.chunks, stats.large_allocations, stats.peak_high_water,
+                stats.total_high_water / stats.resets);
+    for (int i = 0; i < Arena::kBucketNum; ++i) {
+        if (stats.buckets[i]) {
+            NB_LOG_INFO("  [{}, {}) bytes: {}", 1ull << i, 1ull << (i + 1), stats.buckets[i]);
+        }
+    }
+    return 0;
+}
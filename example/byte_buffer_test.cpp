@@ -0,0 +1,88 @@
+#include "byte_buffer.h"
+#include "log.h"
+#include "util.h"
+
+#include <unistd.h>
+#include <random>
+
+using nb::buffer::ByteBuffer;
+
+int main()
+{
+    std::mt19937 rng(42);
+
+    // 随机操作序列，与 std::string 对照
+    ByteBuffer buffer;
+    std::string expected;
+    for (int i = 0; i < 20000; ++i) {
+        size_t len = rng() % 3 == 0 ? rng() % (3 * ByteBuffer::kChunkSize) : rng() % 200;
+        std::string data(len, static_cast<char>('a' + rng() % 26));
+        switch (rng() % 6) {
+            case 0:
+            case 1:
+                buffer.append(data);
+                expected += data;
+                break;
+            case 2:
+                buffer.prepend(data);
+                expected.insert(0, data);
+                break;
+            case 3:
+                buffer.appendOwned(std::string(data));
+                expected += data;
+                break;
+            case 4: {
+                size_t n = rng() % (expected.size() + 1);
+                buffer.consume(n);
+                expected.erase(0, n);
+                break;
+            }
+            default: {
+                size_t n = rng() % (expected.size() + 1);
+                std::string_view view = buffer.contiguous(n);
+                NB_ASSERT(view.size() >= n, "contiguous() returned too few bytes");
+                NB_ASSERT(view == std::string_view(expected).substr(0, view.size()), "contiguous() data mismatch");
+                break;
+            }
+        }
+        NB_ASSERT(buffer.readable() == expected.size(), "readable() mismatch");
+    }
+    NB_ASSERT(buffer.toString() == expected, "content mismatch");
+
+    // 切片
+    size_t offset = expected.size() / 3;
+    size_t len = expected.size() / 3;
+    std::string sliced;
+    for (auto view : buffer.slice(offset, len)) {
+        sliced.append(view);
+    }
+    NB_ASSERT(sliced == expected.substr(offset, len), "slice() mismatch");
+
+    // 通过管道验证 writev / readv
+    int fds[2];
+    NB_ASSERT(pipe(fds) == 0, "pipe() failed");
+    ByteBuffer out;
+    out.append("hello, ");
+    out.appendOwned(std::string(8000, 'x'));
+    out.prepend("[");
+    out.append("]");
+    std::string sent = out.toString();
+    while (!out.empty()) {
+        NB_ASSERT(out.writeFd(fds[1]) > 0, "writeFd() failed");
+    }
+    ByteBuffer in;
+    while (in.readable() < sent.size()) {
+        NB_ASSERT(in.readFd(fds[0]) > 0, "readFd() failed");
+    }
+    NB_ASSERT(in.toString() == sent, "pipe round trip mismatch");
+    close(fds[0]);
+    close(fds[1]);
+
+    // 清空后不再持有块，块回到线程缓存中
+    buffer.clear();
+    in.clear();
+    auto stats = nb::memory::ChunkPool::GetStats();
+    NB_LOG_INFO("ByteBuffer test passed, chunk pool hits {} misses {} cached {}",
+                stats.hits, stats.misses, stats.cached);
+    return 0;
+}
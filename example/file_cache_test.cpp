@@ -0,0 +1,106 @@
+#include "file_cache.h"
+#include "log.h"
+#include "util.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+using nb::http::FileCache;
+
+static void WriteFile(const std::string& path, const std::string& content)
+{
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    ofs << content;
+}
+
+int main()
+{
+    char dir_template[] = "/tmp/file_cache_test_XXXXXX";
+    NB_ASSERT(mkdtemp(dir_template) != nullptr, "mkdtemp() failed");
+    std::string dir = dir_template;
+
+    // 大小文件都整体读入缓存，检查内容与响应头
+    std::string small = "<html>hello</html>";
+    std::string large(200 * 1024, 'z');
+    WriteFile(dir + "/index.html", small);
+    WriteFile(dir + "/large.bin", large);
+
+    FileCache cache(1024 * 1024, 512 * 1024, 50, 1);
+    auto entry = cache.get(dir + "/index.html");
+    NB_ASSERT(entry && entry->content() == small, "small file content mismatch");
+    NB_ASSERT(entry->headers().find("Content-Type: text/html") != std::string_view::npos, "missing Content-Type");
+    NB_ASSERT(entry->headers().find("ETag: " + entry->etag()) != std::string_view::npos, "missing ETag");
+    auto big = cache.get(dir + "/large.bin");
+    NB_ASSERT(big && big->content() == large, "large file content mismatch");
+    NB_ASSERT(cache.get(dir + "/index.html") == entry, "second get() should hit");
+    NB_ASSERT(cache.get(dir + "/missing") == nullptr, "missing file should not be cached");
+
+    // 缓存的是内容快照，文件被截断后已取得的缓存项不受影响
+    WriteFile(dir + "/large.bin", "");
+    NB_ASSERT(big->content() == large, "cached content changed after truncation");
+    WriteFile(dir + "/large.bin", large);
+
+    // 同一秒内大小不变的修改也会得到不同的 ETag
+    WriteFile(dir + "/same.txt", "aaaa");
+    auto before = cache.get(dir + "/same.txt");
+    struct stat st;
+    NB_ASSERT(stat((dir + "/same.txt").c_str(), &st) == 0, "stat() failed");
+    WriteFile(dir + "/same.txt", "bbbb");
+    struct timespec times[2] = {st.st_atim, st.st_mtim};
+    times[1].tv_nsec = (times[1].tv_nsec + 1) % 1000000000;
+    NB_ASSERT(utimensat(AT_FDCWD, (dir + "/same.txt").c_str(), times, 0) == 0, "utimensat() failed");
+    cache.invalidate(dir + "/same.txt");
+    auto after = cache.get(dir + "/same.txt");
+    NB_ASSERT(after->content() == "bbbb", "same-size edit not reloaded");
+    NB_ASSERT(after->etag() != before->etag(), "same-second edit must change the ETag");
+
+    // 条件请求
+    NB_ASSERT(entry->notModified(entry->etag(), ""), "If-None-Match should match");
+    NB_ASSERT(entry->notModified("\"x\", W/" + entry->etag(), ""), "weak ETag in list should match");
+    NB_ASSERT(entry->notModified("*", ""), "If-None-Match * should match");
+    NB_ASSERT(!entry->notModified("\"other\"", entry->lastModified()), "If-None-Match takes precedence");
+    NB_ASSERT(entry->notModified("", entry->lastModified()), "If-Modified-Since should match");
+    NB_ASSERT(!entry->notModified("", ""), "no validators should not match");
+
+    // 修改文件后，超过校验间隔重新加载；旧缓存项仍可被持有者安全读取
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    WriteFile(dir + "/index.html", "<html>changed</html>");
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    auto reloaded = cache.get(dir + "/index.html");
+    NB_ASSERT(reloaded && reloaded->content() == "<html>changed</html>", "changed file not reloaded");
+    NB_ASSERT(entry->content() == small, "old entry content changed");
+
+    // 按字节预算淘汰最久未使用的缓存项
+    for (int i = 0; i < 8; ++i) {
+        WriteFile(dir + "/f" + std::to_string(i), std::string(200 * 1024, static_cast<char>('a' + i)));
+        NB_ASSERT(cache.get(dir + "/f" + std::to_string(i)), "get() failed");
+    }
+    auto stats = cache.getStats();
+    NB_ASSERT(stats.bytes <= 1024 * 1024, "byte budget exceeded");
+    NB_ASSERT(stats.evictions > 0, "expected evictions");
+    NB_ASSERT(big->content() == large, "evicted entry still referenced must stay valid");
+
+    // 超过大小上限的文件不缓存
+    WriteFile(dir + "/huge.bin", std::string(600 * 1024, 'h'));
+    NB_ASSERT(cache.get(dir + "/huge.bin") == nullptr, "oversized file should not be cached");
+    FileCache::Uncached uncached;
+    NB_ASSERT(cache.get(dir + "/huge.bin", &uncached) == nullptr, "oversized file should not be cached");
+    NB_ASSERT(uncached.fd >= 0 && uncached.size == 600 * 1024, "oversized file fd should be handed back");
+    close(uncached.fd);
+    FileCache::Uncached missing;
+    NB_ASSERT(cache.get(dir + "/missing", &missing) == nullptr && missing.fd < 0 && missing.error == ENOENT,
+              "missing file should report ENOENT");
+
+    NB_LOG_INFO("FileCache test passed, hits {} revalidations {} loads {} evictions {} bytes {} entries {}",
+                stats.hits, stats.revalidations, stats.loads, stats.evictions, stats.bytes, stats.entries);
+
+    std::string cmd = "rm -rf " + dir;
+    (void)std::system(cmd.c_str());
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "http_server.h"
+#include "log.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// 本地回环压测：启动 HttpServer，由若干客户端线程通过 keep-alive 连接发送流水线请求，
+// 统计吞吐与每批请求的往返延迟。
+// 用法: http_bench [连接数] [流水线深度] [持续秒数] [服务器线程数]
+
+static constexpr uint16_t kPort = 18080;
+
+static int Connect()
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(kPort);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    int on = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return fd;
+}
+
+/**
+ * @brief 从缓冲区中数出完整的响应数并移除它们
+ */
+static int ConsumeResponses(std::string& buffer)
+{
+    int count = 0;
+    size_t pos = 0;
+    while (true) {
+        size_t header_end = buffer.find("\r\n\r\n", pos);
+        if (header_end == std::string::npos) {
+            break;
+        }
+        size_t length_pos = buffer.find("Content-Length: ", pos);
+        size_t length = 0;
+        if (length_pos != std::string::npos && length_pos < header_end) {
+            length = std::strtoul(buffer.c_str() + length_pos + 16, nullptr, 10);
+        }
+        if (buffer.size() < header_end + 4 + length) {
+            break;
+        }
+        pos = header_end + 4 + length;
+        ++count;
+    }
+    buffer.erase(0, pos);
+    return count;
+}
+
+int main(int argc, char** argv)
+{
+    int connections = argc > 1 ? std::atoi(argv[1]) : 8;
+    int depth = argc > 2 ? std::atoi(argv[2]) : 16;
+    int seconds = argc > 3 ? std::atoi(argv[3]) : 5;
+    int server_threads = argc > 4 ? std::atoi(argv[4]) : 2;
+
+    nb::scheduler::Scheduler scheduler(server_threads, "http");
+    scheduler.start();
+    nb::http::HttpServer server(scheduler, "127.0.0.1", kPort);
+    server.addRoute("/hello", [](const nb::http::HttpRequest&, nb::http::HttpResponse& resp) {
+        resp.setHeader("Content-Type", "text/plain");
+        resp.setBody("Hello, World!");
+    });
+    if (!server.start()) {
+        return 1;
+    }
+
+    std::string request;
+    for (int i = 0; i < depth; ++i) {
+        request += "GET /hello HTTP/1.1\r\nHost: 127.0.0.1\r\nUser-Agent: nb-bench\r\nAccept: */*\r\n\r\n";
+    }
+
+    std::atomic<bool> running {true};
+    std::atomic<uint64_t> total_requests {0};
+    std::vector<std::vector<uint64_t>> latencies(connections);
+    std::vector<std::thread> clients;
+    for (int c = 0; c < connections; ++c) {
+        clients.emplace_back([&, c]() {
+            int fd = Connect();
+            if (fd < 0) {
+                NB_LOG_ERROR("connect failed: {}", strerror(errno));
+                return;
+            }
+            std::string buffer;
+            char data[64 * 1024];
+            while (running) {
+                auto begin = std::chrono::steady_clock::now();
+                if (::write(fd, request.data(), request.size()) != static_cast<ssize_t>(request.size())) {
+                    break;
+                }
+                int received = 0;
+                while (received < depth) {
+                    ssize_t n = ::read(fd, data, sizeof(data));
+                    if (n <= 0) {
+                        ::close(fd);
+                        return;
+                    }
+                    buffer.append(data, n);
+                    received += ConsumeResponses(buffer);
+                }
+                auto end = std::chrono::steady_clock::now();
+                latencies[c].push_back(
+                    std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+                total_requests += depth;
+            }
+            ::close(fd);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    running = false;
+    for (auto& client : clients) {
+        client.join();
+    }
+    server.stop();
+    scheduler.stop();
+
+    std::vector<uint64_t> all;
+    for (auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&](double p) -> uint64_t {
+        return all.empty() ? 0 : all[std::min(all.size() - 1, static_cast<size_t>(all.size() * p))];
+    };
+
+    NB_LOG_INFO("connections={} depth={} duration={}s server_threads={}",
+                connections, depth, seconds, server_threads);
+    NB_LOG_INFO("requests={} throughput={:.0f} req/s", total_requests.load(),
+                total_requests.load() / static_cast<double>(seconds));
+    NB_LOG_INFO("batch latency (us): p50={} p90={} p99={} max={}",
+                percentile(0.5), percentile(0.9), percentile(0.99), all.empty() ? 0 : all.back());
+    return 0;
+}
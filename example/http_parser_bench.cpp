@@ -0,0 +1,67 @@
+#include "http_parser.h"
+#include "log.h"
+
+#include <chrono>
+#include <string>
+
+// 请求解析吞吐压测，分别测量各扫描实现解析流水线请求的 GB/s。
+// 用法: http_parser_bench [总数据量 MB]
+
+using nb::http::HttpRequest;
+using nb::http::HttpRequestParser;
+using nb::http::ParseResult;
+
+static const char kRequest[] =
+    "GET /static/js/app.4f3c2a1b.js?v=20240101 HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.9,zh-CN;q=0.8\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Referer: https://www.example.com/articles/2024/01/coroutine-scheduling\r\n"
+    "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark; lang=en\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+int main(int argc, char** argv)
+{
+    size_t total_mb = argc > 1 ? std::atoi(argv[1]) : 512;
+
+    // 一个缓冲区中放置大量流水线请求
+    std::string buffer;
+    while (buffer.size() < 4 * 1024 * 1024) {
+        buffer += kRequest;
+    }
+    size_t rounds = std::max<size_t>(1, total_mb * 1024 * 1024 / buffer.size());
+
+    for (auto impl : {HttpRequestParser::ScanImpl::SCALAR,
+                      HttpRequestParser::ScanImpl::SSE42,
+                      HttpRequestParser::ScanImpl::AVX2}) {
+        if (!HttpRequestParser::SetScanImpl(impl)) {
+            continue;
+        }
+
+        HttpRequestParser parser;
+        HttpRequest req;
+        size_t requests = 0;
+        size_t bytes = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; ++round) {
+            std::string_view data(buffer);
+            while (parser.parse(data, req) == ParseResult::COMPLETE) {
+                data.remove_prefix(parser.consumed());
+                bytes += parser.consumed();
+                parser.reset();
+                ++requests;
+            }
+            parser.reset();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        NB_LOG_INFO("{:>7}: {:.2f} GB/s, {:.2f} M req/s ({} requests, {} bytes)",
+                    HttpRequestParser::GetScanImplName(), bytes / seconds / 1e9,
+                    requests / seconds / 1e6, requests, bytes);
+    }
+    HttpRequestParser::SetScanImpl(HttpRequestParser::ScanImpl::AUTO);
+    return 0;
+}
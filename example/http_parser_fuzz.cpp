@@ -0,0 +1,176 @@
+#include "http_parser.h"
+#include "log.h"
+
+#include <dirent.h>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 请求解析器的差分模糊测试：
+// 以逐字节实现一次性解析的结果为基准，检查各扫描实现在任意切分读取边界下的结果与之一致，
+// 并对语料做随机变异。
+// 用法: http_parser_fuzz [语料目录] [变异次数]
+
+using nb::http::HttpRequest;
+using nb::http::HttpRequestParser;
+using nb::http::ParseResult;
+
+/**
+ * @brief 把解析结果序列化为可比较的字符串
+ */
+static void Describe(const HttpRequest& req, std::string& out)
+{
+    out += "C ";
+    out.append(req.method).append("|").append(req.path).append("|").append(req.version);
+    for (const auto& header : req.headers) {
+        out.append("|").append(header.name).append(":").append(header.value);
+    }
+    out.append("|").append(req.body).append("\n");
+}
+
+/**
+ * @brief 按给定的切分点逐段喂入数据，解析出所有请求
+ * @param input 完整输入
+ * @param splits 递增的可读长度序列，最后一个应为 input.size()
+ */
+static std::string ParseSplit(const std::string& input, const std::vector<size_t>& splits)
+{
+    std::string out;
+    HttpRequestParser parser;
+    HttpRequest req;
+    size_t start = 0;
+    for (size_t available : splits) {
+        while (true) {
+            ParseResult result = parser.parse(std::string_view(input).substr(start, available - start), req);
+            if (result == ParseResult::ERROR) {
+                return out + "E\n";
+            }
+            if (result == ParseResult::INCOMPLETE) {
+                break;
+            }
+            Describe(req, out);
+            start += parser.consumed();
+            parser.reset();
+        }
+    }
+    return out + "I\n";
+}
+
+static std::vector<size_t> RandomSplits(size_t size, std::mt19937& rng)
+{
+    std::vector<size_t> splits;
+    size_t pos = 0;
+    while (pos < size) {
+        // 偏向很小的分段，以覆盖停在 \r 与向量边界上的情况
+        size_t step = rng() % 4 == 0 ? rng() % 64 + 1 : rng() % 3 + 1;
+        pos = std::min(size, pos + step);
+        splits.push_back(pos);
+    }
+    if (splits.empty()) {
+        splits.push_back(0);
+    }
+    return splits;
+}
+
+static std::vector<std::string> LoadCorpus(const std::string& dir)
+{
+    std::vector<std::string> corpus;
+    DIR* d = opendir(dir.c_str());
+    if (d == nullptr) {
+        return corpus;
+    }
+    while (dirent* entry = readdir(d)) {
+        std::string name = entry->d_name;
+        if (name.size() < 5 || name.substr(name.size() - 5) != ".http") {
+            continue;
+        }
+        std::ifstream ifs(dir + "/" + name, std::ios::binary);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        corpus.push_back(ss.str());
+    }
+    closedir(d);
+    return corpus;
+}
+
+static void Mutate(std::string& input, std::mt19937& rng)
+{
+    static const char kInteresting[] = "\r\n :\t\x00\x7f\x80HTTP/1.1";
+    int mutations = rng() % 4 + 1;
+    for (int i = 0; i < mutations; ++i) {
+        size_t pos = input.empty() ? 0 : rng() % input.size();
+        char c = rng() % 2 ? kInteresting[rng() % (sizeof(kInteresting) - 1)] : static_cast<char>(rng());
+        switch (rng() % 3) {
+            case 0:
+                if (!input.empty()) input[pos] = c;
+                break;
+            case 1:
+                input.insert(input.begin() + pos, c);
+                break;
+            default:
+                if (!input.empty()) input.erase(pos, 1);
+                break;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string source = __FILE__;
+    std::string dir = argc > 1 ? argv[1] : source.substr(0, source.rfind('/')) + "/http_corpus";
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 20000;
+
+    std::vector<std::string> corpus = LoadCorpus(dir);
+    if (corpus.empty()) {
+        NB_LOG_ERROR("No corpus found in {}", dir);
+        return 1;
+    }
+
+    std::vector<HttpRequestParser::ScanImpl> impls = {HttpRequestParser::ScanImpl::SCALAR};
+    if (HttpRequestParser::SetScanImpl(HttpRequestParser::ScanImpl::SSE42)) {
+        impls.push_back(HttpRequestParser::ScanImpl::SSE42);
+    }
+    if (HttpRequestParser::SetScanImpl(HttpRequestParser::ScanImpl::AVX2)) {
+        impls.push_back(HttpRequestParser::ScanImpl::AVX2);
+    }
+
+    std::mt19937 rng(12345);
+    int failures = 0;
+    auto check = [&](const std::string& input) {
+        HttpRequestParser::SetScanImpl(HttpRequestParser::ScanImpl::SCALAR);
+        std::string expected = ParseSplit(input, {input.size()});
+        for (auto impl : impls) {
+            HttpRequestParser::SetScanImpl(impl);
+            for (int round = 0; round < 4; ++round) {
+                std::vector<size_t> splits = round == 0 ? std::vector<size_t>{input.size()}
+                                                        : RandomSplits(input.size(), rng);
+                std::string actual = ParseSplit(input, splits);
+                if (actual != expected) {
+                    NB_LOG_ERROR("Mismatch with {} scan\ninput: {:?}\nexpected: {}actual: {}",
+                                 HttpRequestParser::GetScanImplName(), input, expected, actual);
+                    ++failures;
+                    return;
+                }
+            }
+        }
+    };
+
+    for (const auto& input : corpus) {
+        check(input);
+    }
+    for (int i = 0; i < iterations && failures < 10; ++i) {
+        std::string input = corpus[rng() % corpus.size()];
+        if (rng() % 4 == 0) {
+            // 拼接两个样本，模拟流水线
+            input += corpus[rng() % corpus.size()];
+        }
+        Mutate(input, rng);
+        check(input);
+    }
+
+    HttpRequestParser::SetScanImpl(HttpRequestParser::ScanImpl::AUTO);
+    NB_LOG_INFO("Fuzzed {} corpus entries and {} mutations, {} failures", corpus.size(), iterations, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#include "scheduler.h"
+#include "log.h"
+#include "util.h"
+#include <unistd.h>
+
+int main()
+{
+    nb::scheduler::Scheduler io_scheduler(1, "io");
+    nb::scheduler::Scheduler cpu_scheduler(2, "cpu");
+    io_scheduler.start();
+    cpu_scheduler.start();
+
+    for (int n = 0; n < 3; ++n) {
+        io_scheduler.schedule([&io_scheduler, &cpu_scheduler, n]() {
+            NB_LOG_INFO("task {} on scheduler {}, tid {}", n,
+                        nb::scheduler::Scheduler::GetThis()->getName(), nb::util::GetThreadId());
+
+            // 计算密集的部分迁移到 cpu 调度器上执行
+            bool moved = nb::scheduler::Scheduler::switch_to(cpu_scheduler);
+            NB_ASSERT(moved, "switch_to(cpu) failed");
+            NB_ASSERT(nb::scheduler::Scheduler::GetThis() == &cpu_scheduler, "task should run on cpu scheduler");
+            uint64_t sum = 0;
+            for (uint64_t i = 0; i < 10000000; ++i) {
+                sum += i * n;
+            }
+            NB_LOG_INFO("task {} computed {} on scheduler {}, tid {}", n, sum,
+                        nb::scheduler::Scheduler::GetThis()->getName(), nb::util::GetThreadId());
+
+            // 计算完成后回到 io 调度器
+            moved = nb::scheduler::Scheduler::switch_to(io_scheduler);
+            NB_ASSERT(moved, "switch_to(io) failed");
+            NB_ASSERT(nb::scheduler::Scheduler::GetThis() == &io_scheduler, "task should be back on io scheduler");
+            NB_LOG_INFO("task {} back on scheduler {}, tid {}", n,
+                        nb::scheduler::Scheduler::GetThis()->getName(), nb::util::GetThreadId());
+        });
+    }
+
+    sleep(3);
+    cpu_scheduler.stop();
+    io_scheduler.stop();
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include "scheduler.h"
+#include "trace.h"
+#include "log.h"
+#include <unistd.h>
+
+int main()
+{
+    nb::trace::Tracer::GetInstance().enable();
+
+    nb::scheduler::Scheduler io_scheduler(1, "io");
+    nb::scheduler::Scheduler cpu_scheduler(2, "cpu");
+    io_scheduler.start();
+    cpu_scheduler.start();
+
+    for (int n = 0; n < 4; ++n) {
+        io_scheduler.schedule([&io_scheduler, &cpu_scheduler]() {
+            for (int i = 0; i < 3; ++i) {
+                nb::coroutine::Coroutine::Yield();
+            }
+            nb::scheduler::Scheduler::switch_to(cpu_scheduler);
+            volatile uint64_t sum = 0;
+            for (uint64_t i = 0; i < 1000000; ++i) {
+                sum += i;
+            }
+            nb::scheduler::Scheduler::switch_to(io_scheduler);
+        });
+    }
+
+    sleep(1);
+    cpu_scheduler.stop();
+    io_scheduler.stop();
+
+    nb::trace::Tracer::GetInstance().disable();
+    if (nb::trace::Tracer::GetInstance().dump("trace.json")) {
+        NB_LOG_INFO("Trace written to trace.json, open it with chrome://tracing or ui.perfetto.dev");
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "scheduler.h"
+#include "watchdog.h"
+#include "log.h"
+#include <unistd.h>
+
+static void busy_loop(int ms)
+{
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+int main()
+{
+    nb::watchdog::Watchdog::GetInstance().start(50, 5);
+
+    nb::scheduler::Scheduler scheduler(2, "watchdog");
+    scheduler.start();
+
+    // 表现良好的协程：频繁让出
+    scheduler.schedule([]() {
+        for (int i = 0; i < 20; ++i) {
+            busy_loop(1);
+            nb::coroutine::Coroutine::Yield();
+        }
+    });
+
+    // 失控的协程：长时间不让出
+    scheduler.schedule([]() {
+        busy_loop(10);
+        nb::coroutine::Coroutine::Yield();
+        busy_loop(200);
+    });
+
+    // 迁移后长时间运行的协程：运行片段应归到调用 switch_to 的位置，而不是 switch_to 内部
+    nb::scheduler::Scheduler cpu_scheduler(1, "cpu");
+    cpu_scheduler.start();
+    scheduler.schedule([&cpu_scheduler]() {
+        nb::scheduler::Scheduler::switch_to(cpu_scheduler);
+        busy_loop(120);
+    });
+
+    sleep(2);
+    cpu_scheduler.stop();
+    scheduler.stop();
+    nb::watchdog::Watchdog::GetInstance().stop();
+    NB_LOG_INFO("{}", nb::watchdog::Watchdog::GetInstance().report());
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "arena.h"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+namespace nb {
+namespace memory {
+
+/**
+ * @brief 全局统计，reset 时以原子操作汇总，不与分配路径竞争
+ */
+struct GlobalStats
+{
+    std::atomic<uint64_t> resets {0};
+    std::atomic<uint64_t> chunks {0};
+    std::atomic<uint64_t> large_allocations {0};
+    std::atomic<size_t> peak_high_water {0};
+    std::atomic<uint64_t> total_high_water {0};
+    std::atomic<uint64_t> buckets[Arena::kBucketNum] = {};
+};
+
+static GlobalStats s_stats;        //!  全部 Arena 的统计信息
+
+static inline char* AlignUp(char* p, size_t alignment)
+{
+    uintptr_t v = reinterpret_cast<uintptr_t>(p);
+    return reinterpret_cast<char*>((v + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+}
+
+Arena::~Arena()
+{
+    reset();
+}
+
+void Arena::new_chunk()
+{
+    char* chunk = static_cast<char*>(ChunkPool::Allocate());
+    ChunkHeader* header = reinterpret_cast<ChunkHeader*>(chunk);
+    header->next = chunks_;
+    chunks_ = header;
+    cur_ = chunk + sizeof(ChunkHeader);
+    end_ = chunk + kChunkSize;
+    chunk_num_++;
+}
+
+void* Arena::allocate_large(size_t bytes, size_t alignment)
+{
+    // 先分配记录，保证申请大内存后不会因记录分配失败而泄漏
+    LargeBlock* block = static_cast<LargeBlock*>(do_allocate(sizeof(LargeBlock), alignof(LargeBlock)));
+    void* ptr = ::operator new(bytes, std::align_val_t(alignment));
+    block->next = large_;
+    block->ptr = ptr;
+    block->bytes = bytes;
+    block->alignment = alignment;
+    large_ = block;
+    large_num_++;
+    return ptr;
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment)
+{
+    if (bytes + alignment > kLargeThreshold) {
+        used_ += bytes;
+        return allocate_large(bytes, alignment);
+    }
+
+    char* p = cur_ ? AlignUp(cur_, alignment) : nullptr;
+    if (p == nullptr || p + bytes > end_) {
+        new_chunk();
+        p = AlignUp(cur_, alignment);
+    }
+    cur_ = p + bytes;
+    used_ += bytes;
+    return p;
+}
+
+void Arena::do_deallocate(void*, size_t, size_t)
+{
+    // 单调分配，内存在 reset() 时统一释放
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void Arena::reset()
+{
+    if (used_ > 0) {
+        s_stats.resets.fetch_add(1, std::memory_order_relaxed);
+        s_stats.chunks.fetch_add(chunk_num_, std::memory_order_relaxed);
+        s_stats.large_allocations.fetch_add(large_num_, std::memory_order_relaxed);
+        s_stats.total_high_water.fetch_add(used_, std::memory_order_relaxed);
+        size_t peak = s_stats.peak_high_water.load(std::memory_order_relaxed);
+        while (used_ > peak && !s_stats.peak_high_water.compare_exchange_weak(peak, used_, std::memory_order_relaxed)) {
+        }
+        int bucket = 63 - __builtin_clzll(used_);
+        s_stats.buckets[bucket < kBucketNum ? bucket : kBucketNum - 1].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 大分配的记录位于块中，先释放大分配再归还块
+    for (LargeBlock* block = large_; block; block = block->next) {
+        ::operator delete(block->ptr, block->bytes, std::align_val_t(block->alignment));
+    }
+    while (chunks_) {
+        ChunkHeader* next = chunks_->next;
+        ChunkPool::Deallocate(chunks_);
+        chunks_ = next;
+    }
+
+    high_water_ = highWater();
+    large_ = nullptr;
+    cur_ = nullptr;
+    end_ = nullptr;
+    used_ = 0;
+    chunk_num_ = 0;
+    large_num_ = 0;
+}
+
+Arena::Stats Arena::GetStats()
+{
+    Stats stats;
+    stats.resets = s_stats.resets.load(std::memory_order_relaxed);
+    stats.chunks = s_stats.chunks.load(std::memory_order_relaxed);
+    stats.large_allocations = s_stats.large_allocations.load(std::memory_order_relaxed);
+    stats.peak_high_water = s_stats.peak_high_water.load(std::memory_order_relaxed);
+    stats.total_high_water = s_stats.total_high_water.load(std::memory_order_relaxed);
+    for (int i = 0; i < kBucketNum; ++i) {
+        stats.buckets[i] = s_stats.buckets[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+}
+}
@@ -0,0 +1,120 @@
+#ifndef NB_ARENA_H
+#define NB_ARENA_H
+
+#include "chunk_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace nb {
+namespace memory {
+
+/**
+ * @brief 单调分配的内存区域
+ * @details 小对象从线程私有块池取得的 16KB 块中顺序切分，释放为空操作，reset() 时整体归还；
+ *          超过阈值的分配单独向系统申请，同样在 reset() 时释放。实现了 std::pmr::memory_resource，
+ *          可直接作为 pmr 容器的内存来源。非线程安全，同一时刻只应被一个协程使用。
+ */
+class Arena : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t kChunkSize = ChunkPool::kChunkSize;     // 块大小
+    static constexpr size_t kLargeThreshold = kChunkSize / 4;       // 单独申请的最小分配大小
+    static constexpr int kBucketNum = 32;       // 直方图桶数，第 i 个桶覆盖 [2^i, 2^(i+1)) 字节
+
+    /**
+     * @brief 全部 Arena 的统计信息，在每次 reset() 时汇总
+     */
+    struct Stats
+    {
+        uint64_t resets = 0;                    // 有过分配的 reset 次数
+        uint64_t chunks = 0;                    // 取用的块数
+        uint64_t large_allocations = 0;         // 单独申请的大分配次数
+        size_t peak_high_water = 0;             // 单次使用量的最大值
+        uint64_t total_high_water = 0;          // 单次使用量之和，除以 resets 得到平均值
+        uint64_t buckets[kBucketNum] = {0};     // 单次使用量的分布
+    };
+
+public:
+    Arena() = default;
+
+    /**
+     * @brief 析构函数，归还所有内存
+     */
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief 整体释放所有分配，块归还当前线程的块池
+     * @details 调用前必须确保没有对象仍在使用其中的内存
+     */
+    void reset();
+
+    /**
+     * @brief 自上次 reset() 以来分配的字节数
+     */
+    size_t used() const { return used_; }
+
+    /**
+     * @brief 各次 reset() 之间使用量的最大值
+     */
+    size_t highWater() const { return used_ > high_water_ ? used_ : high_water_; }
+
+    /**
+     * @brief 获取全部 Arena 的统计信息
+     */
+    static Stats GetStats();
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    /**
+     * @brief 块头，位于每个块的起始处，串成链表
+     */
+    struct ChunkHeader
+    {
+        ChunkHeader* next;
+    };
+
+    /**
+     * @brief 大分配的记录，本身从块中分配
+     */
+    struct LargeBlock
+    {
+        LargeBlock* next;
+        void* ptr;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    /**
+     * @brief 取一个新块作为当前块
+     */
+    void new_chunk();
+
+    /**
+     * @brief 单独申请一块大内存
+     */
+    void* allocate_large(size_t bytes, size_t alignment);
+
+private:
+    char* cur_ = nullptr;                   // 当前块的空闲起点
+    char* end_ = nullptr;                   // 当前块的末尾
+    ChunkHeader* chunks_ = nullptr;         // 已取用的块
+    LargeBlock* large_ = nullptr;           // 大分配
+    size_t used_ = 0;                       // 自上次 reset 以来分配的字节数
+    size_t high_water_ = 0;                 // 之前各次 reset 时的最大使用量
+    uint64_t chunk_num_ = 0;                // 自上次 reset 以来取用的块数
+    uint64_t large_num_ = 0;                // 自上次 reset 以来的大分配次数
+};
+
+}
+}
+
+#endif // NB_ARENA_H
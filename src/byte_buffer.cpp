@@ -0,0 +1,317 @@
+#include "byte_buffer.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace nb {
+namespace buffer {
+
+static constexpr int kReadChunks = 2;      //!  readFd 每次最多额外申请的块数
+
+ByteBuffer::~ByteBuffer()
+{
+    clear();
+}
+
+ByteBuffer::ByteBuffer(ByteBuffer&& other) noexcept
+    : chunks_(std::move(other.chunks_))
+    , head_(other.head_)
+    , readable_(other.readable_)
+{
+    other.chunks_.clear();
+    other.head_ = 0;
+    other.readable_ = 0;
+}
+
+ByteBuffer& ByteBuffer::operator=(ByteBuffer&& other) noexcept
+{
+    if (this != &other) {
+        clear();
+        chunks_ = std::move(other.chunks_);
+        head_ = other.head_;
+        readable_ = other.readable_;
+        other.chunks_.clear();
+        other.head_ = 0;
+        other.readable_ = 0;
+    }
+    return *this;
+}
+
+ByteBuffer::Chunk ByteBuffer::NewChunk(size_t capacity)
+{
+    Chunk chunk;
+    if (capacity <= kChunkSize) {
+        chunk.data = static_cast<char*>(memory::ChunkPool::Allocate());
+        chunk.capacity = kChunkSize;
+    } else {
+        chunk.data = static_cast<char*>(std::malloc(capacity));
+        if (chunk.data == nullptr) {
+            throw std::bad_alloc();
+        }
+        chunk.capacity = capacity;
+    }
+    return chunk;
+}
+
+void ByteBuffer::FreeChunk(Chunk& chunk)
+{
+    if (chunk.owner) {
+        chunk.owner.reset();
+    } else if (chunk.capacity == kChunkSize) {
+        memory::ChunkPool::Deallocate(chunk.data);
+    } else {
+        std::free(chunk.data);
+    }
+    chunk.data = nullptr;
+}
+
+void ByteBuffer::append(const void* data, size_t len)
+{
+    const char* src = static_cast<const char*>(data);
+    readable_ += len;
+    while (len > 0) {
+        if (head_ == chunks_.size() || chunks_.back().writable() == 0) {
+            chunks_.push_back(NewChunk(kChunkSize));
+        }
+        Chunk& tail = chunks_.back();
+        size_t n = std::min(len, tail.writable());
+        std::memcpy(tail.data + tail.end, src, n);
+        tail.end += n;
+        src += n;
+        len -= n;
+    }
+}
+
+void ByteBuffer::appendOwned(std::string&& data)
+{
+    if (data.size() < kOwnThreshold) {
+        append(data.data(), data.size());
+        return;
+    }
+    auto owner = std::make_shared<std::string>(std::move(data));
+    const char* ptr = owner->data();
+    size_t len = owner->size();
+    appendRef(std::move(owner), ptr, len);
+}
+
+void ByteBuffer::appendRef(std::shared_ptr<const void> owner, const char* data, size_t len)
+{
+    if (len == 0) {
+        return;
+    }
+    Chunk chunk;
+    chunk.data = const_cast<char*>(data);
+    chunk.capacity = len;
+    chunk.end = len;
+    chunk.owner = std::move(owner);
+    chunks_.push_back(std::move(chunk));
+    readable_ += len;
+}
+
+void ByteBuffer::prepend(const void* data, size_t len)
+{
+    if (len == 0) {
+        return;
+    }
+    if (head_ < chunks_.size() && !chunks_[head_].owner && chunks_[head_].begin >= len) {
+        Chunk& first = chunks_[head_];
+        first.begin -= len;
+        std::memcpy(first.data + first.begin, data, len);
+        readable_ += len;
+        return;
+    }
+
+    // 数据放在新块的尾部，后续的 prepend 仍可以写在它前面
+    Chunk chunk = NewChunk(len);
+    chunk.begin = chunk.capacity - len;
+    chunk.end = chunk.capacity;
+    std::memcpy(chunk.data + chunk.begin, data, len);
+    if (head_ > 0) {
+        chunks_[--head_] = std::move(chunk);
+    } else {
+        chunks_.insert(chunks_.begin(), std::move(chunk));
+    }
+    readable_ += len;
+}
+
+void ByteBuffer::consume(size_t n)
+{
+    n = std::min(n, readable_);
+    readable_ -= n;
+    while (n > 0) {
+        Chunk& first = chunks_[head_];
+        size_t size = first.size();
+        if (n < size) {
+            first.begin += n;
+            break;
+        }
+        n -= size;
+        FreeChunk(first);
+        ++head_;
+    }
+
+    if (head_ == chunks_.size()) {
+        // 所有块都已消费：归还块并释放块数组本身，空闲连接不占用内存
+        clear();
+    } else if (head_ >= 16 && head_ * 2 >= chunks_.size()) {
+        // 已消费的块位置过多时整体前移
+        chunks_.erase(chunks_.begin(), chunks_.begin() + head_);
+        head_ = 0;
+    }
+}
+
+void ByteBuffer::clear()
+{
+    for (size_t i = head_; i < chunks_.size(); ++i) {
+        FreeChunk(chunks_[i]);
+    }
+    std::vector<Chunk>().swap(chunks_);
+    head_ = 0;
+    readable_ = 0;
+}
+
+std::string_view ByteBuffer::front() const
+{
+    if (head_ == chunks_.size()) {
+        return {};
+    }
+    const Chunk& first = chunks_[head_];
+    return std::string_view(first.data + first.begin, first.size());
+}
+
+std::string_view ByteBuffer::contiguous(size_t n)
+{
+    n = std::min(n, readable_);
+    if (head_ == chunks_.size() || chunks_[head_].size() >= n) {
+        return front();
+    }
+
+    // 合并出一个能容纳全部可读数据的块，容量至少为 n 的两倍以便后续读入继续追加
+    size_t capacity = std::max(readable_, n * 2);
+    Chunk merged = NewChunk(capacity);
+    size_t copy = std::min(readable_, merged.capacity);
+    size_t copied = 0;
+    while (copied < copy) {
+        Chunk& first = chunks_[head_];
+        size_t len = std::min(first.size(), copy - copied);
+        std::memcpy(merged.data + copied, first.data + first.begin, len);
+        copied += len;
+        first.begin += len;
+        if (first.size() == 0) {
+            FreeChunk(first);
+            ++head_;
+        }
+    }
+    merged.end = copied;
+
+    if (head_ > 0) {
+        chunks_[--head_] = std::move(merged);
+    } else {
+        chunks_.insert(chunks_.begin(), std::move(merged));
+    }
+    return front();
+}
+
+std::vector<std::string_view> ByteBuffer::slice(size_t offset, size_t len) const
+{
+    std::vector<std::string_view> views;
+    for (size_t i = head_; i < chunks_.size() && len > 0; ++i) {
+        const Chunk& chunk = chunks_[i];
+        if (offset >= chunk.size()) {
+            offset -= chunk.size();
+            continue;
+        }
+        size_t n = std::min(len, chunk.size() - offset);
+        views.emplace_back(chunk.data + chunk.begin + offset, n);
+        offset = 0;
+        len -= n;
+    }
+    return views;
+}
+
+std::string ByteBuffer::toString() const
+{
+    std::string result;
+    result.reserve(readable_);
+    for (size_t i = head_; i < chunks_.size(); ++i) {
+        result.append(chunks_[i].data + chunks_[i].begin, chunks_[i].size());
+    }
+    return result;
+}
+
+int ByteBuffer::peek(iovec* iov, int max_iov) const
+{
+    int count = 0;
+    for (size_t i = head_; i < chunks_.size() && count < max_iov; ++i) {
+        if (chunks_[i].size() > 0) {
+            iov[count].iov_base = chunks_[i].data + chunks_[i].begin;
+            iov[count].iov_len = chunks_[i].size();
+            ++count;
+        }
+    }
+    return count;
+}
+
+ssize_t ByteBuffer::readFd(int fd)
+{
+    // 末块的空闲空间加上若干新块，一次 readv 读入
+    iovec iov[kReadChunks + 1];
+    Chunk fresh[kReadChunks];
+    int count = 0;
+    bool has_tail = head_ < chunks_.size() && chunks_.back().writable() > 0;
+    if (has_tail) {
+        Chunk& tail = chunks_.back();
+        iov[count].iov_base = tail.data + tail.end;
+        iov[count].iov_len = tail.writable();
+        ++count;
+    }
+    for (int i = 0; i < kReadChunks; ++i) {
+        fresh[i] = NewChunk(kChunkSize);
+        iov[count].iov_base = fresh[i].data;
+        iov[count].iov_len = fresh[i].capacity;
+        ++count;
+    }
+
+    ssize_t n = ::readv(fd, iov, count);
+    int saved_errno = errno;
+    size_t left = n > 0 ? static_cast<size_t>(n) : 0;
+    readable_ += left;
+    if (has_tail) {
+        Chunk& tail = chunks_.back();
+        size_t len = std::min(left, tail.writable());
+        tail.end += len;
+        left -= len;
+    }
+    for (int i = 0; i < kReadChunks; ++i) {
+        if (left > 0) {
+            fresh[i].end = std::min(left, fresh[i].capacity);
+            left -= fresh[i].end;
+            chunks_.push_back(std::move(fresh[i]));
+        } else {
+            FreeChunk(fresh[i]);
+        }
+    }
+    errno = saved_errno;
+    return n;
+}
+
+ssize_t ByteBuffer::writeFd(int fd)
+{
+    iovec iov[kMaxIov];
+    int count = peek(iov, kMaxIov);
+    if (count == 0) {
+        return 0;
+    }
+    ssize_t n = ::writev(fd, iov, count);
+    if (n > 0) {
+        consume(static_cast<size_t>(n));
+    }
+    return n;
+}
+
+}
+}
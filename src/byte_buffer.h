@@ -0,0 +1,154 @@
+#ifndef NB_BYTE_BUFFER_H
+#define NB_BYTE_BUFFER_H
+
+#include "chunk_pool.h"
+
+#include <sys/uio.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nb {
+namespace buffer {
+
+/**
+ * @brief 由定长块串成的字节缓冲区
+ * @details 数据存放在从线程私有块池中取得的 16KB 块中，追加数据与读入 socket 数据时
+ *          只在末尾追加新块，不会整体重新分配与搬移；消费掉的块立即归还块池，
+ *          缓冲区为空时不持有任何块。支持 readv 直接读入空闲块、writev 直接写出已排队的块，
+ *          也可以追加对外部只读内存的引用（例如大响应体），发送时同样不拷贝。
+ */
+class ByteBuffer
+{
+public:
+    static constexpr size_t kChunkSize = memory::ChunkPool::kChunkSize;   // 块大小
+    static constexpr int kMaxIov = 64;                                      // 单次 readv/writev 的最大段数
+    static constexpr size_t kOwnThreshold = 4 * 1024;                       // appendOwned 接管所有权的最小长度
+
+public:
+    ByteBuffer() = default;
+    ~ByteBuffer();
+
+    ByteBuffer(const ByteBuffer&) = delete;
+    ByteBuffer& operator=(const ByteBuffer&) = delete;
+    ByteBuffer(ByteBuffer&& other) noexcept;
+    ByteBuffer& operator=(ByteBuffer&& other) noexcept;
+
+    /**
+     * @brief 可读字节数
+     */
+    size_t readable() const { return readable_; }
+    bool empty() const { return readable_ == 0; }
+
+    /**
+     * @brief 在末尾追加数据（拷贝）
+     */
+    void append(const void* data, size_t len);
+    void append(std::string_view data) { append(data.data(), data.size()); }
+
+    /**
+     * @brief 在末尾追加一个字符串，较大的字符串接管其所有权而不拷贝
+     */
+    void appendOwned(std::string&& data);
+
+    /**
+     * @brief 在末尾追加一段外部只读内存的引用，不拷贝
+     * @param owner 保证内存有效的持有者，数据被消费后释放
+     * @param data 数据起点
+     * @param len 数据长度
+     */
+    void appendRef(std::shared_ptr<const void> owner, const char* data, size_t len);
+
+    /**
+     * @brief 在头部插入数据，首块前部有空间时直接写入，否则在头部插入新块
+     */
+    void prepend(const void* data, size_t len);
+    void prepend(std::string_view data) { prepend(data.data(), data.size()); }
+
+    /**
+     * @brief 丢弃头部 n 个字节，完全消费的块归还块池
+     */
+    void consume(size_t n);
+
+    /**
+     * @brief 清空缓冲区，归还所有块
+     */
+    void clear();
+
+    /**
+     * @brief 首块中的可读数据
+     */
+    std::string_view front() const;
+
+    /**
+     * @brief 保证头部至少 min(n, readable()) 个字节位于同一块中并返回首块的可读数据
+     * @details 只有数据跨块时才拷贝；合并出的块容量按需翻倍，后续读入的数据会继续
+     *          写在该块的尾部，因此逐步增长的大请求不会反复拷贝
+     */
+    std::string_view contiguous(size_t n);
+
+    /**
+     * @brief 获取 [offset, offset + len) 范围内数据的切片，跨块时返回多段
+     */
+    std::vector<std::string_view> slice(size_t offset, size_t len) const;
+
+    /**
+     * @brief 拷贝出全部可读数据，主要用于调试
+     */
+    std::string toString() const;
+
+    /**
+     * @brief 用 readv 从 fd 读取数据，写入末块的空闲空间与新申请的块
+     * @return 读到的字节数；0 表示对端关闭；-1 表示出错，errno 有效
+     */
+    ssize_t readFd(int fd);
+
+    /**
+     * @brief 用 writev 将已排队的数据写到 fd，并消费已写出的部分
+     * @return 写出的字节数；-1 表示出错，errno 有效
+     */
+    ssize_t writeFd(int fd);
+
+    /**
+     * @brief 以 iovec 形式获取头部的数据段，不消费
+     * @return 填充的段数
+     */
+    int peek(iovec* iov, int max_iov) const;
+
+private:
+    /**
+     * @brief 一个数据块，[begin, end) 为可读数据，[end, capacity) 为可写空间
+     */
+    struct Chunk
+    {
+        char* data = nullptr;
+        size_t capacity = 0;
+        size_t begin = 0;
+        size_t end = 0;
+        std::shared_ptr<const void> owner;          // 引用外部内存时的持有者，此时块只读
+
+        size_t size() const { return end - begin; }
+        size_t writable() const { return owner ? 0 : capacity - end; }
+    };
+
+    /**
+     * @brief 申请一个容量至少为 capacity 的块，标准大小的块来自块池
+     */
+    static Chunk NewChunk(size_t capacity);
+
+    /**
+     * @brief 释放一个块
+     */
+    static void FreeChunk(Chunk& chunk);
+
+private:
+    std::vector<Chunk> chunks_;         // 块序列，[head_, size) 有效
+    size_t head_ = 0;                   // 首个有效块的下标，避免从 vector 头部删除
+    size_t readable_ = 0;               // 可读字节总数
+};
+
+}
+}
+
+#endif // NB_BYTE_BUFFER_H
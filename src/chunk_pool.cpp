@@ -0,0 +1,74 @@
+#include "chunk_pool.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace nb {
+namespace memory {
+
+/**
+ * @brief 线程私有的空闲块链表，链表指针直接存放在空闲块的头部
+ */
+struct LocalPool
+{
+    struct FreeChunk
+    {
+        FreeChunk* next;
+    };
+
+    FreeChunk* head = nullptr;
+    ChunkPool::Stats stats;
+
+    ~LocalPool()
+    {
+        while (head) {
+            FreeChunk* next = head->next;
+            std::free(head);
+            head = next;
+        }
+    }
+};
+
+static thread_local LocalPool t_pool;      //!  当前线程的块缓存
+
+void* ChunkPool::Allocate()
+{
+    LocalPool& pool = t_pool;
+    if (pool.head) {
+        LocalPool::FreeChunk* chunk = pool.head;
+        pool.head = chunk->next;
+        pool.stats.cached--;
+        pool.stats.hits++;
+        return chunk;
+    }
+    pool.stats.misses++;
+    void* chunk = std::malloc(kChunkSize);
+    if (chunk == nullptr) {
+        throw std::bad_alloc();
+    }
+    return chunk;
+}
+
+void ChunkPool::Deallocate(void* chunk)
+{
+    if (chunk == nullptr) {
+        return;
+    }
+    LocalPool& pool = t_pool;
+    if (pool.stats.cached >= kMaxCachedChunks) {
+        std::free(chunk);
+        return;
+    }
+    LocalPool::FreeChunk* free_chunk = static_cast<LocalPool::FreeChunk*>(chunk);
+    free_chunk->next = pool.head;
+    pool.head = free_chunk;
+    pool.stats.cached++;
+}
+
+ChunkPool::Stats ChunkPool::GetStats()
+{
+    return t_pool.stats;
+}
+
+}
+}
@@ -0,0 +1,52 @@
+#ifndef NB_CHUNK_POOL_H
+#define NB_CHUNK_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nb {
+namespace memory {
+
+/**
+ * @brief 定长内存块的线程私有缓存池
+ * @details 每个线程维护一个空闲块链表，分配与归还都不加锁；缓存的块数超过上限时
+ *          直接归还给系统。块可以在任意线程归还，归还到当前线程的缓存中。
+ */
+class ChunkPool
+{
+public:
+    static constexpr size_t kChunkSize = 16 * 1024;         // 块大小
+    static constexpr size_t kMaxCachedChunks = 256;         // 每个线程最多缓存的块数
+
+    /**
+     * @brief 当前线程缓存池的统计信息
+     */
+    struct Stats
+    {
+        uint64_t hits = 0;          // 从缓存中取得的次数
+        uint64_t misses = 0;        // 缓存为空时向系统申请的次数
+        size_t cached = 0;          // 当前缓存的块数
+    };
+
+public:
+    /**
+     * @brief 分配一个 kChunkSize 字节的块
+     * @throw std::bad_alloc 系统内存不足
+     */
+    static void* Allocate();
+
+    /**
+     * @brief 归还一个由 Allocate 分配的块
+     */
+    static void Deallocate(void* chunk);
+
+    /**
+     * @brief 获取当前线程缓存池的统计信息
+     */
+    static Stats GetStats();
+};
+
+}
+}
+
+#endif // NB_CHUNK_POOL_H
@@ -1,7 +1,9 @@
 #include "coroutine.h"
+#include "arena.h"
 #include "log.h"
 #include "util.h"
 #include "scheduler.h"
+#include "trace.h"
 namespace nb {
 namespace coroutine {
 static thread_local Coroutine* current_coroutine = nullptr;     //!  当前正在工作的协程
@@ -15,7 +17,11 @@ Coroutine::Coroutine(std::function<void()> cb, size_t stack_size)
         , stack_size_(stack_size)
 {
     s_fiber_count++;
+    if (cb_) {
+        entry_type_ = &cb_.target_type();
+    }
     NB_LOG_INFO("Creating new coroutine, id: {}, total: {}", id_, s_fiber_count);
+    trace::Tracer::GetInstance().record(trace::EventType::CREATE, id_);
     stack_ = malloc(stack_size_);
     
     getcontext(&context_);
@@ -50,20 +56,28 @@ void Coroutine::Resume()
 
     current_coroutine = this;
     state_ = State::RUNNING;
+    thread_id_ = util::GetThreadId();
     swapcontext(&scheduler::Scheduler::GetMainContext()->context_, &context_);
     current_coroutine = nullptr;
 }
 
 void Coroutine::Yield() 
+{
+    Yield(__builtin_return_address(0));
+}
+
+void Coroutine::Yield(const void* site)
 {
     NB_ASSERT(current_coroutine != nullptr, "Yield() called outside any coroutine");
     current_coroutine->state_ = State::READY;
+    current_coroutine->yield_site_ = site;
     swapcontext(&current_coroutine->context_, &scheduler::Scheduler::GetMainContext()->context_);
 }
 
 Coroutine::~Coroutine() 
 {
     s_fiber_count--;
+    arena_.reset();
     NB_LOG_INFO("Destroying coroutine, id: {}, total: {}", id_, s_fiber_count);
     if (stack_) {
         NB_ASSERT(state_ == State::FINISHED || state_ == State::EXCEPTION || state_ == State::READY,
@@ -80,6 +94,23 @@ Coroutine* Coroutine::GetThis()
     return current_coroutine;
 }
 
+memory::Arena& Coroutine::getArena()
+{
+    if (!arena_) {
+        arena_.reset(new memory::Arena());
+    }
+    return *arena_;
+}
+
+std::pmr::memory_resource* Coroutine::GetArena()
+{
+    // 主协程不会结束，其中的分配无法整体释放，使用默认的 memory_resource
+    if (current_coroutine == nullptr || current_coroutine->stack_ == nullptr) {
+        return std::pmr::get_default_resource();
+    }
+    return &current_coroutine->getArena();
+}
+
 void Coroutine::CoroutineEntryPoint() 
 {
     Coroutine* co = Coroutine::GetThis();
@@ -100,6 +131,10 @@ void Coroutine::CoroutineEntryPoint()
     }
 
     co->cb_ = nullptr;
+    // 入口函数及其捕获的对象均已销毁，整体释放内存区域，块归还当前线程的块池
+    if (co->arena_) {
+        co->arena_->reset();
+    }
     swapcontext(&co->context_, &scheduler::Scheduler::GetMainContext()->context_);
 }
 
@@ -4,8 +4,14 @@
 #include <ucontext.h>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <typeinfo>
 
 namespace nb {
+namespace memory {
+class Arena;
+}
+
 namespace coroutine {
 
 class Coroutine : public std::enable_shared_from_this<Coroutine> {
@@ -41,6 +47,34 @@ public:
 
     State getState() const { return state_; }
 
+    /**
+     * @brief 获取协程 ID
+     */
+    uint64_t getId() const { return id_; }
+
+    /**
+     * @brief 获取协程上一次让出的位置（Yield 的返回地址）
+     * @return 尚未让出过时返回 nullptr
+     */
+    const void* getYieldSite() const { return yield_site_; }
+
+    /**
+     * @brief 获取协程入口函数的类型信息，用于标识协程由哪段代码创建
+     */
+    const std::type_info& getEntryType() const { return *entry_type_; }
+
+    /**
+     * @brief 获取协程最近一次运行所在的线程 ID
+     * @return 尚未运行过时返回 0
+     */
+    uint64_t getThreadId() const { return thread_id_; }
+
+    /**
+     * @brief 获取协程的内存区域，首次调用时创建
+     * @details 协程结束或销毁时整体释放，期间分配的内存不能被协程之外的对象持有
+     */
+    memory::Arena& getArena();
+
     /**
      * @brief 暂停当前协程的执行，切换回主协程
      * @return void
@@ -48,6 +82,14 @@ public:
      */
     static void Yield();
 
+    /**
+     * @brief 暂停当前协程的执行，并以 site 作为让出位置
+     * @details 供封装了 Yield 的函数（如 Scheduler::switch_to）传入其调用者的返回地址，
+     *          使看门狗按真正的调用点统计运行片段，而不是全部归到封装函数内部
+     * @param site 让出位置
+     */
+    static void Yield(const void* site);
+
     /** 
      * @brief 获取当前协程对象
      * @return 当前协程指针
@@ -59,6 +101,12 @@ public:
      * @return 协程 ID
      */
     static uint64_t GetFiberId();
+
+    /**
+     * @brief 获取当前协程的内存区域，用作 pmr 容器的内存来源
+     * @return 不在子协程中时返回默认的 memory_resource
+     */
+    static std::pmr::memory_resource* GetArena();
 private:
     //! 协程的入口函数
     static void CoroutineEntryPoint(); 
@@ -69,6 +117,10 @@ private:
     std::function<void()> cb_;                  // 协程执行的函数
     State state_ = State::READY;                // 协程状态
     int id_;                                    // 协程 ID
+    const void *yield_site_ = nullptr;          // 上一次让出的位置
+    const std::type_info *entry_type_ = &typeid(void); // 入口函数类型
+    uint64_t thread_id_ = 0;                    // 最近一次运行所在的线程
+    std::unique_ptr<memory::Arena> arena_;      // 内存区域，按需创建
 };
 
 }
@@ -0,0 +1,259 @@
+#include "file_cache.h"
+#include "http.h"
+#include "log.h"
+#include "util.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <functional>
+
+namespace nb {
+namespace http {
+
+static std::string FormatHttpDate(time_t t)
+{
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    char buf[64];
+    size_t n = strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return std::string(buf, n);
+}
+
+/**
+ * @brief 比较两个 ETag，忽略弱校验前缀 W/
+ */
+static bool EtagMatch(std::string_view a, std::string_view b)
+{
+    if (a.substr(0, 2) == "W/") a.remove_prefix(2);
+    if (b.substr(0, 2) == "W/") b.remove_prefix(2);
+    return a == b;
+}
+
+bool FileCache::Entry::notModified(std::string_view if_none_match, std::string_view if_modified_since) const
+{
+    // If-None-Match 存在时优先于 If-Modified-Since
+    if (!if_none_match.empty()) {
+        while (!if_none_match.empty()) {
+            size_t comma = if_none_match.find(',');
+            std::string_view tag = if_none_match.substr(0, comma);
+            while (!tag.empty() && tag.front() == ' ') tag.remove_prefix(1);
+            while (!tag.empty() && tag.back() == ' ') tag.remove_suffix(1);
+            if (tag == "*" || EtagMatch(tag, etag_)) {
+                return true;
+            }
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            if_none_match.remove_prefix(comma + 1);
+        }
+        return false;
+    }
+    return !if_modified_since.empty() && if_modified_since == last_modified_;
+}
+
+FileCache::FileCache(size_t byte_budget, size_t max_file_size, uint64_t revalidate_ms, size_t shard_num)
+    : shard_budget_(byte_budget / (shard_num ? shard_num : 1))
+    , max_file_size_(std::min(max_file_size, shard_budget_))
+    , revalidate_ms_(revalidate_ms)
+{
+    shard_num = shard_num ? shard_num : 1;
+    for (size_t i = 0; i < shard_num; ++i) {
+        shards_.emplace_back(new Shard());
+    }
+}
+
+FileCache::Shard& FileCache::shard_for(const std::string& path)
+{
+    return *shards_[std::hash<std::string>()(path) % shards_.size()];
+}
+
+std::shared_ptr<FileCache::Entry> FileCache::load(const std::string& path, Uncached* uncached)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (uncached) {
+            uncached->error = errno;
+        }
+        return nullptr;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        if (uncached) {
+            uncached->error = ENOENT;
+        }
+        return nullptr;
+    }
+    if (static_cast<size_t>(st.st_size) > max_file_size_) {
+        // 不缓存，已打开的 fd 直接交给调用者发送
+        if (uncached) {
+            uncached->fd = fd;
+            uncached->size = static_cast<size_t>(st.st_size);
+        } else {
+            ::close(fd);
+        }
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->path_ = path;
+    entry->size_ = static_cast<size_t>(st.st_size);
+    entry->mtime_ = st.st_mtim.tv_sec;
+    entry->mtime_nsec_ = st.st_mtim.tv_nsec;
+    entry->ino_ = st.st_ino;
+
+    entry->content_.resize(entry->size_);
+    size_t done = 0;
+    while (done < entry->size_) {
+        ssize_t n = ::pread(fd, &entry->content_[done], entry->size_ - done, done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+
+    // 读取期间文件被修改时放弃缓存，避免内容与 ETag 不一致
+    struct stat after;
+    if (::fstat(fd, &after) < 0) {
+        ::close(fd);
+        if (uncached) {
+            uncached->error = errno;
+        }
+        return nullptr;
+    }
+    if (done != entry->size_ || after.st_size != st.st_size ||
+        after.st_mtim.tv_sec != st.st_mtim.tv_sec || after.st_mtim.tv_nsec != st.st_mtim.tv_nsec) {
+        // 文件正在被改写，交给调用者按当前内容发送
+        if (uncached) {
+            uncached->fd = fd;
+            uncached->size = static_cast<size_t>(after.st_size);
+        } else {
+            ::close(fd);
+        }
+        return nullptr;
+    }
+    ::close(fd);
+
+    // 秒级时间无法区分同一秒内的修改，ETag 同时包含纳秒与 inode，与重新校验使用的条件一致
+    entry->etag_ = fmt::format("\"{:x}-{:x}-{:x}.{:x}\"", static_cast<uint64_t>(entry->ino_), entry->size_,
+                               static_cast<uint64_t>(entry->mtime_), static_cast<uint64_t>(entry->mtime_nsec_));
+    entry->last_modified_ = FormatHttpDate(entry->mtime_);
+    entry->headers_ = fmt::format("Content-Type: {}\r\nETag: {}\r\nLast-Modified: {}\r\n",
+                                  GetContentType(path), entry->etag_, entry->last_modified_);
+    entry->checked_ms_ = util::NowMs();
+    loads_++;
+    return entry;
+}
+
+void FileCache::erase_locked(Shard& shard, const std::string& path)
+{
+    auto it = shard.index.find(path);
+    if (it == shard.index.end()) {
+        return;
+    }
+    shard.bytes -= (*it->second)->size_;
+    shard.lru.erase(it->second);
+    shard.index.erase(it);
+}
+
+void FileCache::insert(Shard& shard, const std::shared_ptr<Entry>& entry)
+{
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    erase_locked(shard, entry->path_);
+    shard.lru.push_front(entry);
+    shard.index[entry->path_] = shard.lru.begin();
+    shard.bytes += entry->size_;
+
+    // 淘汰最久未使用的缓存项；正在发送的响应仍持有引用，内容在发送完成后才释放
+    while (shard.bytes > shard_budget_ && shard.lru.size() > 1) {
+        std::string victim = shard.lru.back()->path_;
+        erase_locked(shard, victim);
+        evictions_++;
+    }
+}
+
+FileCache::EntryPtr FileCache::get(const std::string& path, Uncached* uncached)
+{
+    Shard& shard = shard_for(path);
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        auto it = shard.index.find(path);
+        if (it != shard.index.end()) {
+            entry = *it->second;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        }
+    }
+
+    if (entry) {
+        uint64_t now = util::NowMs();
+        if (now - entry->checked_ms_.load(std::memory_order_relaxed) <= revalidate_ms_) {
+            hits_++;
+            return entry;
+        }
+
+        // 超过校验间隔，确认文件是否变化
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode) &&
+            st.st_mtim.tv_sec == entry->mtime_ && st.st_mtim.tv_nsec == entry->mtime_nsec_ &&
+            static_cast<size_t>(st.st_size) == entry->size_ && st.st_ino == entry->ino_) {
+            entry->checked_ms_.store(now, std::memory_order_relaxed);
+            revalidations_++;
+            return entry;
+        }
+    }
+
+    std::shared_ptr<Entry> loaded = load(path, uncached);
+    if (!loaded) {
+        // 只有存在过期的缓存项时才需要加锁移除
+        if (entry) {
+            invalidate(path);
+        }
+        return nullptr;
+    }
+    insert(shard, loaded);
+    return loaded;
+}
+
+void FileCache::invalidate(const std::string& path)
+{
+    Shard& shard = shard_for(path);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    erase_locked(shard, path);
+}
+
+void FileCache::clear()
+{
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mtx);
+        shard->lru.clear();
+        shard->index.clear();
+        shard->bytes = 0;
+    }
+}
+
+FileCache::Stats FileCache::getStats() const
+{
+    Stats stats;
+    stats.hits = hits_;
+    stats.revalidations = revalidations_;
+    stats.loads = loads_;
+    stats.evictions = evictions_;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mtx);
+        stats.bytes += shard->bytes;
+        stats.entries += shard->lru.size();
+    }
+    return stats;
+}
+
+}
+}
@@ -0,0 +1,170 @@
+#ifndef NB_FILE_CACHE_H
+#define NB_FILE_CACHE_H
+
+#include <sys/types.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nb {
+namespace http {
+
+/**
+ * @brief 静态文件内存缓存
+ * @details 按路径哈希分片，每个分片独立加锁并维护按字节预算淘汰的 LRU。缓存项持有文件内容的
+ *          一份拷贝（而不是文件映射，文件被截断或原地改写时已缓存的内容不受影响）以及预先格式化好的
+ *          Content-Type / ETag / Last-Modified 响应头。缓存项在重新校验间隔内直接命中，不产生任何文件系统调用；
+ *          超过间隔后通过 stat 比较 mtime、大小与 inode 判断是否需要重新加载。
+ */
+class FileCache
+{
+public:
+    using ptr = std::shared_ptr<FileCache>;
+
+    /**
+     * @brief 缓存项，创建后只读，可被多个连接同时引用
+     */
+    class Entry
+    {
+    public:
+        /**
+         * @brief 文件内容
+         */
+        std::string_view content() const { return content_; }
+
+        /**
+         * @brief 预先格式化的响应头行（Content-Type、ETag、Last-Modified）
+         */
+        std::string_view headers() const { return headers_; }
+
+        const std::string& etag() const { return etag_; }
+        const std::string& lastModified() const { return last_modified_; }
+
+        /**
+         * @brief 根据 If-None-Match / If-Modified-Since 判断客户端缓存是否仍然有效
+         */
+        bool notModified(std::string_view if_none_match, std::string_view if_modified_since) const;
+
+    private:
+        friend class FileCache;
+
+        std::string path_;                          // 文件路径
+        std::string content_;                       // 文件内容
+        size_t size_ = 0;                           // 文件大小
+        std::string headers_;                       // 预先格式化的响应头
+        std::string etag_;                          // ETag
+        std::string last_modified_;                 // Last-Modified
+        time_t mtime_ = 0;                          // 修改时间（秒）
+        long mtime_nsec_ = 0;                       // 修改时间（纳秒部分）
+        ino_t ino_ = 0;                             // inode
+        mutable std::atomic<uint64_t> checked_ms_ {0};  // 最近一次校验的时间
+    };
+
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    /**
+     * @brief get() 未返回缓存项时的文件信息，使调用者不必重复打开文件
+     */
+    struct Uncached
+    {
+        int fd = -1;                    // 文件存在但无法缓存（超过大小上限或读取期间被修改）时已打开的 fd，由调用者关闭
+        size_t size = 0;                // fd 对应文件的大小，读取期间被修改时为读取结束后的大小
+        int error = 0;                  // 打开失败时的 errno，不是普通文件时为 ENOENT
+    };
+
+    /**
+     * @brief 缓存统计信息
+     */
+    struct Stats
+    {
+        uint64_t hits = 0;              // 命中且无需校验
+        uint64_t revalidations = 0;     // 超过校验间隔后 stat 确认未变化
+        uint64_t loads = 0;             // 加载或重新加载
+        uint64_t evictions = 0;         // 因预算淘汰
+        size_t bytes = 0;               // 当前缓存的字节数
+        size_t entries = 0;             // 当前缓存项数
+    };
+
+public:
+    /**
+     * @brief 构造函数
+     * @param byte_budget 缓存内容的总字节预算
+     * @param max_file_size 可缓存的最大文件，更大的文件由调用者走 sendfile
+     * @param revalidate_ms 缓存项重新校验的间隔
+     * @param shard_num 分片数量
+     */
+    explicit FileCache(size_t byte_budget = 64 * 1024 * 1024,
+                       size_t max_file_size = 4 * 1024 * 1024,
+                       uint64_t revalidate_ms = 1000,
+                       size_t shard_num = 16);
+
+    /**
+     * @brief 获取文件的缓存项，未缓存或已变化时加载
+     * @param path 文件完整路径
+     * @param uncached 非空时，未返回缓存项的原因及已打开的 fd 写入其中
+     * @return 缓存项；文件不存在、不是普通文件、超过大小上限或读取期间被修改时返回 nullptr
+     */
+    EntryPtr get(const std::string& path, Uncached* uncached = nullptr);
+
+    /**
+     * @brief 移除一个缓存项
+     */
+    void invalidate(const std::string& path);
+
+    /**
+     * @brief 清空缓存
+     */
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief 分片，独立加锁
+     */
+    struct Shard
+    {
+        std::mutex mtx;
+        std::list<std::shared_ptr<Entry>> lru;      // 越靠前越新
+        std::unordered_map<std::string, std::list<std::shared_ptr<Entry>>::iterator> index;
+        size_t bytes = 0;
+    };
+
+    Shard& shard_for(const std::string& path);
+
+    /**
+     * @brief 从磁盘加载文件并生成缓存项
+     * @param uncached 非空时，文件超过大小上限则将打开的 fd 交给调用者，而不是关闭
+     */
+    std::shared_ptr<Entry> load(const std::string& path, Uncached* uncached);
+
+    /**
+     * @brief 插入或替换缓存项，并按预算淘汰
+     */
+    void insert(Shard& shard, const std::shared_ptr<Entry>& entry);
+
+    /**
+     * @brief 从分片中移除缓存项（需持有分片锁）
+     */
+    void erase_locked(Shard& shard, const std::string& path);
+
+private:
+    size_t shard_budget_;                       // 每个分片的字节预算
+    size_t max_file_size_;                      // 可缓存的最大文件
+    uint64_t revalidate_ms_;                    // 重新校验间隔
+    std::vector<std::unique_ptr<Shard>> shards_;    // 分片
+    std::atomic<uint64_t> hits_ {0};
+    std::atomic<uint64_t> revalidations_ {0};
+    std::atomic<uint64_t> loads_ {0};
+    std::atomic<uint64_t> evictions_ {0};
+};
+
+}
+}
+
+#endif // NB_FILE_CACHE_H
@@ -0,0 +1,167 @@
+#include "http.h"
+#include "util.h"
+
+#include <unistd.h>
+#include <cstring>
+#include <fmt/format.h>
+
+namespace nb {
+namespace http {
+
+std::string_view HttpRequest::getHeader(std::string_view name) const
+{
+    for (const auto& header : headers) {
+        if (util::EqualsIgnoreCase(header.name, name)) {
+            return header.value;
+        }
+    }
+    return {};
+}
+
+bool HttpRequest::keepAlive() const
+{
+    std::string_view connection = getHeader("Connection");
+    if (version == "HTTP/1.0") {
+        return util::EqualsIgnoreCase(connection, "keep-alive");
+    }
+    return !util::EqualsIgnoreCase(connection, "close");
+}
+
+void HttpRequest::clear()
+{
+    method = {};
+    path = {};
+    version = {};
+    headers.clear();
+    body = {};
+}
+
+HttpResponse::~HttpResponse()
+{
+    if (file_fd_ >= 0) {
+        ::close(file_fd_);
+    }
+}
+
+HttpResponse::HttpResponse(HttpResponse&& other) noexcept
+    : status_(other.status_)
+    , headers_(std::move(other.headers_))
+    , body_(std::move(other.body_))
+    , body_owner_(std::move(other.body_owner_))
+    , body_ref_(other.body_ref_)
+    , headers_owner_(std::move(other.headers_owner_))
+    , raw_headers_(other.raw_headers_)
+    , file_fd_(other.file_fd_)
+    , file_offset_(other.file_offset_)
+    , file_length_(other.file_length_)
+{
+    other.file_fd_ = -1;
+}
+
+HttpResponse& HttpResponse::operator=(HttpResponse&& other) noexcept
+{
+    if (this != &other) {
+        if (file_fd_ >= 0) {
+            ::close(file_fd_);
+        }
+        status_ = other.status_;
+        headers_ = std::move(other.headers_);
+        body_ = std::move(other.body_);
+        body_owner_ = std::move(other.body_owner_);
+        body_ref_ = other.body_ref_;
+        headers_owner_ = std::move(other.headers_owner_);
+        raw_headers_ = other.raw_headers_;
+        file_fd_ = other.file_fd_;
+        file_offset_ = other.file_offset_;
+        file_length_ = other.file_length_;
+        other.file_fd_ = -1;
+    }
+    return *this;
+}
+
+void HttpResponse::setHeader(std::string_view name, std::string_view value)
+{
+    headers_.emplace_back(name, value);
+}
+
+void HttpResponse::setBodyRef(std::shared_ptr<const void> owner, std::string_view body)
+{
+    body_owner_ = std::move(owner);
+    body_ref_ = body.data() ? body : std::string_view("", 0);
+    body_.clear();
+}
+
+void HttpResponse::setRawHeaders(std::shared_ptr<const void> owner, std::string_view headers)
+{
+    headers_owner_ = std::move(owner);
+    raw_headers_ = headers;
+}
+
+void HttpResponse::setFile(int fd, off_t offset, size_t length)
+{
+    if (file_fd_ >= 0) {
+        ::close(file_fd_);
+    }
+    file_fd_ = fd;
+    file_offset_ = offset;
+    file_length_ = length;
+    body_.clear();
+    body_ref_ = {};
+    body_owner_.reset();
+}
+
+void HttpResponse::serializeHeader(bool keep_alive, std::string& out) const
+{
+    fmt::format_to(std::back_inserter(out), "HTTP/1.1 {} {}\r\n", status_, StatusReason(status_));
+    for (const auto& header : headers_) {
+        out.append(header.first).append(": ").append(header.second).append("\r\n");
+    }
+    out.append(raw_headers_.data(), raw_headers_.size());
+    // 304 与 204 不带响应体，也不发送 Content-Length
+    if (status_ != 304 && status_ != 204) {
+        fmt::format_to(std::back_inserter(out), "Content-Length: {}\r\n", getContentLength());
+    }
+    out.append(keep_alive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n");
+}
+
+const char* HttpResponse::StatusReason(int status)
+{
+    switch (status) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 206: return "Partial Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default:  return "Unknown";
+    }
+}
+
+const char* GetContentType(std::string_view path)
+{
+    size_t dot = path.rfind('.');
+    std::string_view ext = dot == std::string_view::npos ? std::string_view() : path.substr(dot + 1);
+    if (ext == "html" || ext == "htm") return "text/html; charset=utf-8";
+    if (ext == "css")  return "text/css";
+    if (ext == "js")   return "application/javascript";
+    if (ext == "json") return "application/json";
+    if (ext == "txt")  return "text/plain; charset=utf-8";
+    if (ext == "png")  return "image/png";
+    if (ext == "jpg" || ext == "jpeg") return "image/jpeg";
+    if (ext == "gif")  return "image/gif";
+    if (ext == "svg")  return "image/svg+xml";
+    if (ext == "ico")  return "image/x-icon";
+    return "application/octet-stream";
+}
+
+}
+}
@@ -0,0 +1,171 @@
+#ifndef NB_HTTP_H
+#define NB_HTTP_H
+
+#include <sys/types.h>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nb {
+namespace http {
+
+/**
+ * @brief 请求头，名称与值均指向连接读缓冲区
+ */
+struct HttpHeader
+{
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * @brief HTTP 请求，所有字段均为连接读缓冲区上的切片，不拷贝数据
+ * @note 只在处理函数调用期间有效，缓冲区被压缩或复用后失效
+ */
+class HttpRequest
+{
+public:
+    /**
+     * @brief 按名称查找请求头，大小写不敏感
+     * @param name 请求头名称
+     * @return 请求头的值，不存在时返回空
+     */
+    std::string_view getHeader(std::string_view name) const;
+
+    /**
+     * @brief 处理完该请求后连接是否保持
+     * @details HTTP/1.1 默认保持，HTTP/1.0 需显式 Connection: keep-alive
+     */
+    bool keepAlive() const;
+
+    /**
+     * @brief 清空所有字段，以便复用对象解析下一个请求
+     */
+    void clear();
+
+public:
+    std::string_view method;                // 请求方法
+    std::string_view path;                  // 请求目标
+    std::string_view version;               // 协议版本，如 HTTP/1.1
+    std::vector<HttpHeader> headers;        // 请求头
+    std::string_view body;                  // 请求体
+};
+
+/**
+ * @brief HTTP 响应，响应体可以是内存数据、对外部只读内存的引用或文件（通过 sendfile 发送）
+ */
+class HttpResponse
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param resource 响应头的内存来源，服务器传入处理协程的内存区域
+     */
+    explicit HttpResponse(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : headers_(resource)
+    {
+    }
+    ~HttpResponse();
+
+    HttpResponse(const HttpResponse&) = delete;
+    HttpResponse& operator=(const HttpResponse&) = delete;
+    HttpResponse(HttpResponse&& other) noexcept;
+    HttpResponse& operator=(HttpResponse&& other) noexcept;
+
+    void setStatus(int status) { status_ = status; }
+    int getStatus() const { return status_; }
+
+    /**
+     * @brief 添加一个响应头，Content-Length 与 Connection 由服务器生成
+     */
+    void setHeader(std::string_view name, std::string_view value);
+
+    /**
+     * @brief 设置内存响应体
+     */
+    void setBody(std::string body)
+    {
+        body_ = std::move(body);
+        body_ref_ = {};
+        body_owner_.reset();
+    }
+    const std::string& getBody() const { return body_; }
+
+    /**
+     * @brief 取走内存响应体，避免发送时拷贝
+     */
+    std::string takeBody() { return std::move(body_); }
+
+    /**
+     * @brief 设置引用外部只读内存的响应体，发送时不拷贝
+     * @param owner 保证内存有效的持有者
+     * @param body 响应体数据
+     */
+    void setBodyRef(std::shared_ptr<const void> owner, std::string_view body);
+    const std::shared_ptr<const void>& getBodyOwner() const { return body_owner_; }
+    std::string_view getBodyRef() const { return body_ref_; }
+
+    /**
+     * @brief 设置预先格式化好的响应头行（每行以 \r\n 结尾），序列化时原样输出
+     * @param owner 保证内存有效的持有者
+     * @param headers 响应头文本
+     */
+    void setRawHeaders(std::shared_ptr<const void> owner, std::string_view headers);
+
+    /**
+     * @brief 设置文件响应体，响应对象接管 fd 并在析构时关闭
+     * @param fd 已打开的文件描述符
+     * @param offset 起始偏移
+     * @param length 发送长度
+     */
+    void setFile(int fd, off_t offset, size_t length);
+    int getFileFd() const { return file_fd_; }
+    off_t getFileOffset() const { return file_offset_; }
+
+    /**
+     * @brief 响应体长度，文件响应体返回文件段长度
+     */
+    size_t getContentLength() const
+    {
+        if (file_fd_ >= 0) {
+            return file_length_;
+        }
+        return body_ref_.data() ? body_ref_.size() : body_.size();
+    }
+
+    /**
+     * @brief 序列化状态行与响应头（包含结尾的空行）
+     * @param keep_alive 是否保持连接
+     * @param out 追加输出的字符串
+     */
+    void serializeHeader(bool keep_alive, std::string& out) const;
+
+    /**
+     * @brief 获取状态码对应的原因短语
+     */
+    static const char* StatusReason(int status);
+
+private:
+    int status_ = 200;                                              // 状态码
+    std::pmr::vector<std::pair<std::pmr::string, std::pmr::string>> headers_;  // 响应头
+    std::string body_;                                              // 内存响应体
+    std::shared_ptr<const void> body_owner_;                        // 引用响应体的持有者
+    std::string_view body_ref_;                                     // 引用的响应体
+    std::shared_ptr<const void> headers_owner_;                     // 预先格式化响应头的持有者
+    std::string_view raw_headers_;                                  // 预先格式化的响应头
+    int file_fd_ = -1;                                              // 文件响应体
+    off_t file_offset_ = 0;                                         // 文件起始偏移
+    size_t file_length_ = 0;                                        // 文件发送长度
+};
+
+/**
+ * @brief 根据文件扩展名推断 Content-Type
+ */
+const char* GetContentType(std::string_view path);
+
+}
+}
+
+#endif // NB_HTTP_H
@@ -0,0 +1,306 @@
+#include "http_parser.h"
+#include "util.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NB_HTTP_PARSER_X86 1
+#endif
+
+namespace nb {
+namespace http {
+
+/**
+ * @brief 行扫描函数：返回 [p, end) 中第一个需要特殊处理的字节（除制表符外的控制字符与 DEL），
+ *        没有则返回 end。行结束符 \r \n 属于控制字符，非法字符也在同一次扫描中被发现。
+ */
+using ScanFunc = const char* (*)(const char* p, const char* end);
+
+static bool IsSpecial(unsigned char c)
+{
+    return (c < 0x20 && c != '\t') || c == 0x7f;
+}
+
+static const char* ScanScalar(const char* p, const char* end)
+{
+    while (p < end && !IsSpecial(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    return p;
+}
+
+#ifdef NB_HTTP_PARSER_X86
+__attribute__((target("sse4.2")))
+static const char* ScanSse42(const char* p, const char* end)
+{
+    // 三个字节区间：0x00-0x08, 0x0a-0x1f, 0x7f
+    const __m128i ranges = _mm_setr_epi8(0x00, 0x08, 0x0a, 0x1f, 0x7f, 0x7f,
+                                         0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int index = _mm_cmpestri(ranges, 6, chunk, 16,
+                                 _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        if (index != 16) {
+            return p + index;
+        }
+        p += 16;
+    }
+    return ScanScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* ScanAvx2(const char* p, const char* end)
+{
+    const __m256i max_ctl = _mm256_set1_epi8(0x1f);
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i del = _mm256_set1_epi8(0x7f);
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        // 无符号 c <= 0x1f 等价于 min(c, 0x1f) == c
+        __m256i ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, max_ctl), chunk);
+        ctl = _mm256_andnot_si256(_mm256_cmpeq_epi8(chunk, tab), ctl);
+        __m256i special = _mm256_or_si256(ctl, _mm256_cmpeq_epi8(chunk, del));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return ScanSse42(p, end);
+}
+#endif
+
+static ScanFunc SelectScan(HttpRequestParser::ScanImpl impl)
+{
+#ifdef NB_HTTP_PARSER_X86
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2");
+    bool sse42 = __builtin_cpu_supports("sse4.2");
+    switch (impl) {
+        case HttpRequestParser::ScanImpl::AUTO:
+            return avx2 ? ScanAvx2 : (sse42 ? ScanSse42 : ScanScalar);
+        case HttpRequestParser::ScanImpl::AVX2:
+            return avx2 ? ScanAvx2 : nullptr;
+        case HttpRequestParser::ScanImpl::SSE42:
+            return sse42 ? ScanSse42 : nullptr;
+        default:
+            return ScanScalar;
+    }
+#else
+    return impl == HttpRequestParser::ScanImpl::AUTO || impl == HttpRequestParser::ScanImpl::SCALAR ?
+           ScanScalar : nullptr;
+#endif
+}
+
+static ScanFunc s_scan = SelectScan(HttpRequestParser::ScanImpl::AUTO);     //!  当前行扫描实现
+
+static bool IsTokenChar(unsigned char c)
+{
+    // RFC 7230 tchar
+    static const bool table[256] = {
+        // 0x00-0x1f
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        //  SP ! " # $ % & ' ( ) * + , - . /
+        0,1,0,1,1,1,1,1,0,0,1,1,0,1,1,0,
+        //  0-9 : ; < = > ?
+        1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0,
+        //  @ A-O
+        0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+        //  P-Z [ \ ] ^ _
+        1,1,1,1,1,1,1,1,1,1,1,0,0,0,1,1,
+        //  ` a-o
+        1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+        //  p-z { | } ~ DEL
+        1,1,1,1,1,1,1,1,1,1,1,0,1,0,1,0,
+    };
+    return table[c];
+}
+
+static std::string_view TrimOws(std::string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+bool HttpRequestParser::SetScanImpl(ScanImpl impl)
+{
+    ScanFunc scan = SelectScan(impl);
+    if (scan == nullptr) {
+        return false;
+    }
+    s_scan = scan;
+    return true;
+}
+
+const char* HttpRequestParser::GetScanImplName()
+{
+#ifdef NB_HTTP_PARSER_X86
+    if (s_scan == ScanAvx2) return "avx2";
+    if (s_scan == ScanSse42) return "sse4.2";
+#endif
+    return "scalar";
+}
+
+void HttpRequestParser::reset()
+{
+    state_ = State::REQUEST_LINE;
+    pos_ = 0;
+    line_start_ = 0;
+    method_ = path_ = version_ = Span{0, 0};
+    headers_.clear();
+    body_start_ = 0;
+    content_length_ = 0;
+}
+
+bool HttpRequestParser::parse_request_line(std::string_view line, uint32_t offset)
+{
+    // METHOD SP TARGET SP HTTP/x.y
+    size_t sp1 = line.find(' ');
+    if (sp1 == std::string_view::npos || sp1 == 0) {
+        return false;
+    }
+    size_t sp2 = line.find(' ', sp1 + 1);
+    if (sp2 == std::string_view::npos || sp2 == sp1 + 1) {
+        return false;
+    }
+    for (size_t i = 0; i < sp1; ++i) {
+        if (!IsTokenChar(static_cast<unsigned char>(line[i]))) {
+            return false;
+        }
+    }
+    std::string_view version = line.substr(sp2 + 1);
+    if (version.size() != 8 || version.substr(0, 5) != "HTTP/" ||
+        version[5] < '0' || version[5] > '9' || version[6] != '.' || version[7] < '0' || version[7] > '9') {
+        return false;
+    }
+    method_ = Span{offset, static_cast<uint32_t>(sp1)};
+    path_ = Span{static_cast<uint32_t>(offset + sp1 + 1), static_cast<uint32_t>(sp2 - sp1 - 1)};
+    version_ = Span{static_cast<uint32_t>(offset + sp2 + 1), 8};
+    return true;
+}
+
+bool HttpRequestParser::parse_header(std::string_view line, uint32_t offset)
+{
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos || colon == 0 || headers_.size() >= kMaxHeaders) {
+        return false;
+    }
+    for (size_t i = 0; i < colon; ++i) {
+        if (!IsTokenChar(static_cast<unsigned char>(line[i]))) {
+            return false;
+        }
+    }
+    std::string_view raw_value = line.substr(colon + 1);
+    std::string_view value = TrimOws(raw_value);
+    uint32_t value_offset = static_cast<uint32_t>(offset + colon + 1 + (value.data() - raw_value.data()));
+    headers_.emplace_back(Span{offset, static_cast<uint32_t>(colon)},
+                          Span{value_offset, static_cast<uint32_t>(value.size())});
+    return true;
+}
+
+bool HttpRequestParser::finish_headers(std::string_view data)
+{
+    content_length_ = 0;
+    bool has_length = false;
+    for (const auto& header : headers_) {
+        std::string_view name = header.first.in(data);
+        if (util::EqualsIgnoreCase(name, "Transfer-Encoding")) {
+            // 不支持分块编码的请求体
+            return false;
+        }
+        if (!util::EqualsIgnoreCase(name, "Content-Length")) {
+            continue;
+        }
+        std::string_view value = header.second.in(data);
+        if (has_length || value.empty()) {
+            return false;
+        }
+        has_length = true;
+        for (char c : value) {
+            if (c < '0' || c > '9' || content_length_ > (1ull << 40)) {
+                return false;
+            }
+            content_length_ = content_length_ * 10 + (c - '0');
+        }
+    }
+    return true;
+}
+
+ParseResult HttpRequestParser::parse(std::string_view data, HttpRequest& req)
+{
+    const char* begin = data.data();
+    const char* end = begin + data.size();
+
+    while (state_ != State::BODY) {
+        const char* p = s_scan(begin + pos_, end);
+        if (p == end) {
+            pos_ = data.size();
+            return pos_ > kMaxHeaderSize ? ParseResult::ERROR : ParseResult::INCOMPLETE;
+        }
+
+        // 找到行结束符，接受 CRLF 与单独的 LF
+        size_t line_end = p - begin;
+        size_t next;
+        if (*p == '\n') {
+            next = line_end + 1;
+        } else if (*p == '\r') {
+            if (p + 1 == end) {
+                // 停在 \r 上，等待下一个字节
+                pos_ = line_end;
+                return ParseResult::INCOMPLETE;
+            }
+            if (p[1] != '\n') {
+                return ParseResult::ERROR;
+            }
+            next = line_end + 2;
+        } else {
+            return ParseResult::ERROR;
+        }
+        if (line_end > kMaxHeaderSize) {
+            return ParseResult::ERROR;
+        }
+
+        std::string_view line = data.substr(line_start_, line_end - line_start_);
+        uint32_t offset = static_cast<uint32_t>(line_start_);
+        if (state_ == State::REQUEST_LINE) {
+            // 忽略请求行之前的空行
+            if (!line.empty()) {
+                if (!parse_request_line(line, offset)) {
+                    return ParseResult::ERROR;
+                }
+                state_ = State::HEADERS;
+            }
+        } else if (line.empty()) {
+            if (!finish_headers(data)) {
+                return ParseResult::ERROR;
+            }
+            body_start_ = next;
+            state_ = State::BODY;
+        } else if (!parse_header(line, offset)) {
+            return ParseResult::ERROR;
+        }
+        pos_ = line_start_ = next;
+    }
+
+    if (data.size() - body_start_ < content_length_) {
+        return ParseResult::INCOMPLETE;
+    }
+
+    req.clear();
+    req.method = method_.in(data);
+    req.path = path_.in(data);
+    req.version = version_.in(data);
+    req.headers.reserve(headers_.size());
+    for (const auto& header : headers_) {
+        req.headers.push_back(HttpHeader{header.first.in(data), header.second.in(data)});
+    }
+    req.body = data.substr(body_start_, content_length_);
+    return ParseResult::COMPLETE;
+}
+
+}
+}
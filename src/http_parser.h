@@ -0,0 +1,125 @@
+#ifndef NB_HTTP_PARSER_H
+#define NB_HTTP_PARSER_H
+
+#include "http.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace nb {
+namespace http {
+
+/**
+ * @brief 请求解析结果
+ */
+enum class ParseResult {
+    COMPLETE = 0,       // 解析出一个完整请求
+    INCOMPLETE,         // 数据不足，需要继续读取
+    ERROR               // 请求格式错误
+};
+
+/**
+ * @brief 可恢复的零拷贝 HTTP/1.x 请求解析器
+ * @details 解析状态以相对请求起点的偏移保存，数据不足时记住已扫描的位置，
+ *          追加数据后从断点继续而不必从头重新解析；缓冲区被移动或扩容也不影响已解析的部分。
+ *          行结束符的查找使用 AVX2 / SSE4.2 一次扫描 16~32 字节，并同时拒绝非法控制字符，
+ *          不支持的平台退化为逐字节扫描。
+ */
+class HttpRequestParser
+{
+public:
+    /**
+     * @brief 行扫描实现
+     */
+    enum class ScanImpl {
+        AUTO = 0,       // 运行时按 CPU 特性选择
+        SCALAR,         // 逐字节
+        SSE42,          // SSE4.2 pcmpestri
+        AVX2            // AVX2 字节比较
+    };
+
+    static constexpr size_t kMaxHeaderSize = 64 * 1024;     // 请求行与请求头的总长度上限
+    static constexpr size_t kMaxHeaders = 100;              // 请求头数量上限
+
+public:
+    HttpRequestParser() { reset(); }
+
+    /**
+     * @brief 解析一个请求
+     * @param data 从当前请求第一个字节开始的全部已读数据，相邻两次调用之间只能在末尾追加
+     * @param req 解析完成时输出的请求，字段为 data 上的切片
+     * @return 解析结果，COMPLETE 之后需调用 reset() 才能解析下一个请求
+     */
+    ParseResult parse(std::string_view data, HttpRequest& req);
+
+    /**
+     * @brief 最近一个完整请求占用的字节数（含请求体）
+     */
+    size_t consumed() const { return body_start_ + content_length_; }
+
+    /**
+     * @brief 重置状态，准备解析下一个请求
+     */
+    void reset();
+
+    /**
+     * @brief 指定行扫描实现，主要用于测试与压测，AUTO 恢复默认选择
+     * @return 设置是否生效，CPU 不支持时返回 false
+     */
+    static bool SetScanImpl(ScanImpl impl);
+
+    /**
+     * @brief 当前使用的行扫描实现名称
+     */
+    static const char* GetScanImplName();
+
+private:
+    /**
+     * @brief 以偏移表示的切片
+     */
+    struct Span
+    {
+        uint32_t offset;
+        uint32_t length;
+
+        std::string_view in(std::string_view data) const { return data.substr(offset, length); }
+    };
+
+    enum class State {
+        REQUEST_LINE = 0,
+        HEADERS,
+        BODY
+    };
+
+    /**
+     * @brief 解析一行请求行
+     */
+    bool parse_request_line(std::string_view line, uint32_t offset);
+
+    /**
+     * @brief 解析一行请求头
+     */
+    bool parse_header(std::string_view line, uint32_t offset);
+
+    /**
+     * @brief 请求头结束后检查请求体长度
+     */
+    bool finish_headers(std::string_view data);
+
+private:
+    State state_;                                   // 当前解析阶段
+    size_t pos_;                                    // 已扫描到的位置
+    size_t line_start_;                             // 当前行的起点
+    Span method_;                                   // 请求方法
+    Span path_;                                     // 请求目标
+    Span version_;                                  // 协议版本
+    std::vector<std::pair<Span, Span>> headers_;    // 请求头
+    size_t body_start_;                             // 请求体起点
+    size_t content_length_;                         // 请求体长度
+};
+
+}
+}
+
+#endif // NB_HTTP_PARSER_H
@@ -0,0 +1,411 @@
+#include "http_server.h"
+#include "log.h"
+#include "util.h"
+#include "byte_buffer.h"
+#include "arena.h"
+#include "poller.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+
+namespace nb {
+namespace http {
+
+static constexpr size_t kMaxRequestSize = 1024 * 1024;          //!  单个请求（含请求体）的上限
+static constexpr size_t kMaxBatchBytes = 256 * 1024;            //!  写缓冲区积累到该大小即先行写出
+static constexpr uint64_t kStopTimeoutMs = 5000;                //!  stop() 等待协程退出的上限
+static constexpr uint64_t kAcceptBackoffMs = 100;               //!  fd 等资源耗尽时 accept 的退避时间
+static constexpr uint64_t kAcceptErrorLogMs = 1000;             //!  资源耗尽日志的最小间隔
+
+/**
+ * @brief 协程退出时（包括因异常退出）关闭 fd 并减少活跃协程计数
+ */
+class CoroutineGuard
+{
+public:
+    CoroutineGuard(int fd, std::atomic<int>& active) : fd_(fd), active_(active) {}
+    ~CoroutineGuard()
+    {
+        ::close(fd_);
+        active_--;
+    }
+
+    CoroutineGuard(const CoroutineGuard&) = delete;
+    CoroutineGuard& operator=(const CoroutineGuard&) = delete;
+
+private:
+    int fd_;
+    std::atomic<int>& active_;
+};
+
+static std::string_view StripQuery(std::string_view path)
+{
+    size_t query = path.find('?');
+    return query == std::string_view::npos ? path : path.substr(0, query);
+}
+
+HttpServer::HttpServer(scheduler::Scheduler& scheduler, const std::string& host, uint16_t port,
+                       int listener_num)
+    : scheduler_(scheduler)
+    , host_(host)
+    , port_(port)
+    , listener_num_(listener_num > 0 ? listener_num : scheduler.getThreadNum())
+{
+}
+
+HttpServer::~HttpServer()
+{
+    stop();
+}
+
+void HttpServer::addRoute(const std::string& path, Handler handler)
+{
+    routes_[path] = std::move(handler);
+}
+
+int HttpServer::create_listener()
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        NB_LOG_ERROR("socket() failed: {}", strerror(errno));
+        return -1;
+    }
+
+    int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port_);
+    if (::inet_pton(AF_INET, host_.c_str(), &addr.sin_addr) != 1) {
+        NB_LOG_ERROR("Invalid listen address: {}", host_);
+        ::close(fd);
+        return -1;
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        NB_LOG_ERROR("bind/listen {}:{} failed: {}", host_, port_, strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool HttpServer::start()
+{
+    if (running_) {
+        return true;
+    }
+
+    std::vector<int> listen_fds;
+    for (int i = 0; i < listener_num_; ++i) {
+        int fd = create_listener();
+        if (fd < 0) {
+            for (int opened : listen_fds) {
+                ::close(opened);
+            }
+            return false;
+        }
+        listen_fds.push_back(fd);
+    }
+
+    poller_.reset(new io::Poller());
+    running_ = true;
+    for (int fd : listen_fds) {
+        active_coroutines_++;
+        scheduler_.schedule(std::function<void()>(std::bind(&HttpServer::accept_loop, this, fd)));
+    }
+    NB_LOG_INFO("HttpServer listening on {}:{} with {} listeners", host_, port_, listener_num_);
+    return true;
+}
+
+void HttpServer::stop()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+    NB_LOG_INFO("Stopping HttpServer on {}:{}", host_, port_);
+
+    // 唤醒所有挂起在 fd 上的协程，它们发现停止标志后自行退出
+    poller_->cancelAll();
+    uint64_t deadline = util::NowMs() + kStopTimeoutMs;
+    while (active_coroutines_ > 0) {
+        if (util::NowMs() > deadline) {
+            // 调度器已先于服务器停止时协程不会再运行；保留 Poller，迟到的 wait() 立即返回 CANCELLED
+            NB_LOG_ERROR("HttpServer on {}:{} stopped with {} coroutines still active, is the scheduler running?",
+                         host_, port_, active_coroutines_.load());
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    poller_.reset();
+}
+
+void HttpServer::accept_loop(int listen_fd)
+{
+    CoroutineGuard guard(listen_fd, active_coroutines_);
+    uint64_t last_log_ms = 0;
+    while (running_) {
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            int err = errno;
+            if (err == EMFILE || err == ENFILE || err == ENOBUFS || err == ENOMEM) {
+                // 资源耗尽时监听 fd 始终可读，等待 EPOLLIN 无法限流，只能定时退避
+                uint64_t now = util::NowMs();
+                if (now - last_log_ms >= kAcceptErrorLogMs) {
+                    NB_LOG_ERROR("accept4() failed: {}, backing off {} ms", strerror(err), kAcceptBackoffMs);
+                    last_log_ms = now;
+                }
+                poller_->wait(listen_fd, 0, kAcceptBackoffMs);
+                continue;
+            }
+            if (err != EAGAIN && err != EINTR && err != ECONNABORTED) {
+                NB_LOG_ERROR("accept4() failed: {}", strerror(err));
+            }
+            if (err == EAGAIN) {
+                poller_->wait(listen_fd, EPOLLIN, 0);
+            } else {
+                coroutine::Coroutine::Yield();
+            }
+            continue;
+        }
+
+        int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        active_coroutines_++;
+        scheduler_.schedule(std::function<void()>(std::bind(&HttpServer::handle_connection, this, fd)));
+    }
+}
+
+void HttpServer::handle_connection(int fd)
+{
+    CoroutineGuard guard(fd, active_coroutines_);
+    buffer::ByteBuffer in;                      // 读缓冲区，请求字段均指向其中
+    buffer::ByteBuffer out;                     // 写缓冲区，本批次待发送的响应
+    HttpRequest req;
+    HttpRequestParser parser;                   // 跨读取保留进度，请求被拆分时不从头重新解析
+    std::string header;
+    bool keep_alive = true;
+    uint64_t last_active = util::NowMs();
+    // 响应及处理函数的临时分配来自协程的内存区域，每批响应发出后整体释放
+    memory::Arena& arena = coroutine::Coroutine::GetThis()->getArena();
+
+    while (keep_alive && running_) {
+        // 处理缓冲区中所有完整的请求（流水线）
+        while (keep_alive && !in.empty()) {
+            std::string_view data = in.front();
+            ParseResult result = parser.parse(data, req);
+            if (result == ParseResult::INCOMPLETE && data.size() < in.readable()) {
+                // 请求跨块，合并到同一块后从断点继续解析
+                data = in.contiguous(std::min(in.readable(), kMaxRequestSize));
+                result = parser.parse(data, req);
+            }
+            if (result == ParseResult::INCOMPLETE) {
+                break;
+            }
+
+            HttpResponse resp(&arena);
+            bool head = false;
+            if (result == ParseResult::ERROR) {
+                resp.setStatus(400);
+                keep_alive = false;
+            } else {
+                keep_alive = req.keepAlive();
+                head = req.method == "HEAD";
+                try {
+                    dispatch(req, resp);
+                } catch (const std::exception& e) {
+                    NB_LOG_ERROR("Handler exception: {}", e.what());
+                    resp = HttpResponse(&arena);
+                    resp.setStatus(500);
+                } catch (...) {
+                    NB_LOG_ERROR("Handler unknown exception");
+                    resp = HttpResponse(&arena);
+                    resp.setStatus(500);
+                }
+                // 请求对象此后不再有效
+                in.consume(parser.consumed());
+                parser.reset();
+            }
+
+            header.clear();
+            resp.serializeHeader(keep_alive && running_, header);
+            out.append(header);
+            if (head) {
+                // HEAD 只发送响应头，Content-Length 保留 GET 时的长度
+            } else if (resp.getFileFd() >= 0) {
+                // 文件响应体：先写出排在前面的数据，再 sendfile
+                if (!flush_all(fd, out) ||
+                    !send_file(fd, resp.getFileFd(), resp.getFileOffset(), resp.getContentLength())) {
+                    keep_alive = false;
+                    out.clear();
+                }
+            } else if (resp.getBodyRef().data()) {
+                // 引用缓存内容的响应体，直接排入发送队列，不拷贝
+                out.appendRef(resp.getBodyOwner(), resp.getBodyRef().data(), resp.getBodyRef().size());
+            } else {
+                out.appendOwned(resp.takeBody());
+            }
+            if (out.readable() >= kMaxBatchBytes && !flush_all(fd, out)) {
+                keep_alive = false;
+                out.clear();
+            }
+        }
+
+        // 本批次的响应合并为一次 writev
+        if (!out.empty() && !flush_all(fd, out)) {
+            break;
+        }
+        arena.reset();
+        if (!keep_alive) {
+            break;
+        }
+
+        if (in.readable() >= kMaxRequestSize) {
+            HttpResponse resp;
+            resp.setStatus(413);
+            header.clear();
+            resp.serializeHeader(false, header);
+            out.append(header);
+            flush_all(fd, out);
+            break;
+        }
+
+        ssize_t n = in.readFd(fd);
+        if (n > 0) {
+            last_active = util::NowMs();
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+            break;
+        }
+        uint64_t idle_ms = util::NowMs() - last_active;
+        if (idle_ms >= keepalive_timeout_ms_) {
+            break;
+        }
+        if (errno == EAGAIN &&
+            poller_->wait(fd, EPOLLIN, keepalive_timeout_ms_ - idle_ms) != io::Poller::WaitResult::READY) {
+            break;
+        }
+    }
+}
+
+bool HttpServer::flush_all(int fd, buffer::ByteBuffer& out)
+{
+    // 超时从最近一次写出进展开始计算，持续缓慢接收的客户端不会被误判
+    while (!out.empty()) {
+        ssize_t n = out.writeFd(fd);
+        if (n >= 0 || errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN || !running_ ||
+            poller_->wait(fd, EPOLLOUT, send_timeout_ms_) != io::Poller::WaitResult::READY) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HttpServer::send_file(int fd, int file_fd, off_t offset, size_t length)
+{
+    while (length > 0) {
+        ssize_t n = ::sendfile(fd, file_fd, &offset, length);
+        if (n > 0) {
+            length -= static_cast<size_t>(n);
+            continue;
+        }
+        if (n == 0) {
+            // 文件被截断
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN || !running_ ||
+            poller_->wait(fd, EPOLLOUT, send_timeout_ms_) != io::Poller::WaitResult::READY) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HttpServer::dispatch(const HttpRequest& req, HttpResponse& resp)
+{
+    auto it = routes_.find(StripQuery(req.path));
+    if (it != routes_.end()) {
+        it->second(req, resp);
+        return;
+    }
+
+    if (!document_root_.empty() && (req.method == "GET" || req.method == "HEAD")) {
+        serve_file(req, resp);
+        return;
+    }
+
+    resp.setStatus(404);
+}
+
+void HttpServer::serve_file(const HttpRequest& req, HttpResponse& resp)
+{
+    std::string_view path = StripQuery(req.path);
+    if (path.empty() || path.front() != '/' || path.find("..") != std::string_view::npos) {
+        resp.setStatus(403);
+        return;
+    }
+
+    std::string full_path = document_root_;
+    full_path.append(path.data(), path.size());
+    if (full_path.back() == '/') {
+        full_path += "index.html";
+    }
+
+    if (file_cache_) {
+        FileCache::Uncached uncached;
+        FileCache::EntryPtr entry = file_cache_->get(full_path, &uncached);
+        if (entry) {
+            resp.setRawHeaders(entry, entry->headers());
+            if (entry->notModified(req.getHeader("If-None-Match"), req.getHeader("If-Modified-Since"))) {
+                resp.setStatus(304);
+            } else {
+                resp.setBodyRef(entry, entry->content());
+            }
+            return;
+        }
+        if (uncached.fd < 0) {
+            resp.setStatus(uncached.error == EACCES ? 403 : 404);
+            return;
+        }
+        // 超过缓存大小上限的文件沿用缓存已打开的 fd 走 sendfile，不再重复 open 与 fstat
+        resp.setHeader("Content-Type", GetContentType(full_path));
+        resp.setFile(uncached.fd, 0, uncached.size);
+        return;
+    }
+
+    int file_fd = ::open(full_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file_fd < 0) {
+        resp.setStatus(errno == EACCES ? 403 : 404);
+        return;
+    }
+    struct stat st;
+    if (::fstat(file_fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        ::close(file_fd);
+        resp.setStatus(404);
+        return;
+    }
+
+    resp.setHeader("Content-Type", GetContentType(full_path));
+    resp.setFile(file_fd, 0, static_cast<size_t>(st.st_size));
+}
+
+}
+}
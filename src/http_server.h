@@ -0,0 +1,147 @@
+#ifndef NB_HTTP_SERVER_H
+#define NB_HTTP_SERVER_H
+
+#include "byte_buffer.h"
+#include "file_cache.h"
+#include "http.h"
+#include "http_parser.h"
+#include "poller.h"
+#include "scheduler.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace nb {
+namespace http {
+
+/**
+ * @brief 基于协程调度器的 HTTP/1.1 服务器
+ * @details 每个工作线程对应一个 SO_REUSEPORT 监听套接字，由内核在监听套接字间分发连接；
+ *          每个连接由一个协程处理，支持 keep-alive 与请求流水线，同一批读到的请求的响应
+ *          合并为一次 writev 发出，文件响应体通过 sendfile 发送。
+ *          套接字均为非阻塞，读写遇到 EAGAIN 时协程挂起在 Poller 上，fd 就绪后才重新调度，
+ *          空闲连接与监听协程不占用调度器。
+ */
+class HttpServer
+{
+public:
+    using ptr = std::shared_ptr<HttpServer>;
+    using Handler = std::function<void(const HttpRequest&, HttpResponse&)>;
+
+public:
+    /**
+     * @brief 构造函数
+     * @param scheduler 运行监听与连接协程的调度器
+     * @param host 监听地址
+     * @param port 监听端口
+     * @param listener_num 监听套接字数量，小于等于 0 时与调度器线程数相同
+     */
+    HttpServer(scheduler::Scheduler& scheduler, const std::string& host, uint16_t port,
+               int listener_num = 0);
+
+    /**
+     * @brief 析构函数，停止服务器
+     */
+    ~HttpServer();
+
+    /**
+     * @brief 注册精确匹配的路由
+     * @param path 请求路径（不含查询参数）
+     * @param handler 处理函数，在连接协程中同步调用；可通过 Coroutine::GetArena() 分配临时内存，
+     *                在本批响应发出后整体释放
+     */
+    void addRoute(const std::string& path, Handler handler);
+
+    /**
+     * @brief 设置静态文件根目录，未匹配路由的 GET 请求从该目录查找文件
+     */
+    void setDocumentRoot(const std::string& root) { document_root_ = root; }
+
+    /**
+     * @brief 设置静态文件缓存，命中时响应体直接引用缓存内容，并支持条件请求返回 304
+     */
+    void setFileCache(FileCache::ptr cache) { file_cache_ = std::move(cache); }
+
+    /**
+     * @brief 设置空闲连接的超时时间
+     */
+    void setKeepAliveTimeout(uint64_t timeout_ms) { keepalive_timeout_ms_ = timeout_ms; }
+
+    /**
+     * @brief 设置发送超时，超过该时间没有任何数据写出时关闭连接
+     */
+    void setSendTimeout(uint64_t timeout_ms) { send_timeout_ms_ = timeout_ms; }
+
+    /**
+     * @brief 创建监听套接字并启动监听协程
+     * @return 是否成功
+     */
+    bool start();
+
+    /**
+     * @brief 停止服务器，等待所有监听与连接协程退出，最多等待 5 秒
+     * @note 应先于调度器停止，否则协程无法再运行，只能等到超时
+     */
+    void stop();
+
+private:
+    /**
+     * @brief 创建一个设置了 SO_REUSEPORT 的非阻塞监听套接字
+     * @return 套接字，失败返回 -1
+     */
+    int create_listener();
+
+    /**
+     * @brief 监听协程，接受连接并为每个连接调度一个协程
+     */
+    void accept_loop(int listen_fd);
+
+    /**
+     * @brief 连接协程，循环读取、解析、处理请求并批量发送响应
+     */
+    void handle_connection(int fd);
+
+    /**
+     * @brief 写出缓冲区中的全部数据
+     * @return 是否全部写出；发送超时或服务器停止时返回 false
+     */
+    bool flush_all(int fd, buffer::ByteBuffer& out);
+
+    /**
+     * @brief 通过 sendfile 发送文件段
+     * @return 是否全部发出；发送超时、文件被截断或服务器停止时返回 false
+     */
+    bool send_file(int fd, int file_fd, off_t offset, size_t length);
+
+    /**
+     * @brief 将请求分发到路由或静态文件
+     */
+    void dispatch(const HttpRequest& req, HttpResponse& resp);
+
+    /**
+     * @brief 从文档根目录打开请求的文件作为响应体
+     */
+    void serve_file(const HttpRequest& req, HttpResponse& resp);
+
+private:
+    scheduler::Scheduler& scheduler_;                           // 调度器
+    std::string host_;                                          // 监听地址
+    uint16_t port_;                                             // 监听端口
+    int listener_num_;                                          // 监听套接字数量
+    std::map<std::string, Handler, std::less<>> routes_;        // 路由表
+    std::string document_root_;                                 // 静态文件根目录
+    FileCache::ptr file_cache_;                                 // 静态文件缓存
+    uint64_t keepalive_timeout_ms_ = 60 * 1000;                 // 空闲连接超时
+    uint64_t send_timeout_ms_ = 30 * 1000;                      // 发送超时
+    std::unique_ptr<io::Poller> poller_;                        // fd 就绪等待
+    std::atomic<bool> running_ {false};                         // 是否正在运行
+    std::atomic<int> active_coroutines_ {0};                    // 尚未退出的监听与连接协程数
+};
+
+}
+}
+
+#endif // NB_HTTP_SERVER_H
@@ -0,0 +1,114 @@
+#include "poller.h"
+#include "log.h"
+#include "util.h"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace nb {
+namespace io {
+
+Poller::Poller()
+{
+    epfd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    NB_ASSERT(epfd_ >= 0, "epoll_create1() failed");
+    thread_ = std::thread(&Poller::loop, this);
+}
+
+Poller::~Poller()
+{
+    cancelAll();
+    stop_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ::close(epfd_);
+}
+
+Poller::WaitResult Poller::wait(int fd, uint32_t events, uint64_t timeout_ms)
+{
+    scheduler::Scheduler* scheduler = scheduler::Scheduler::GetThis();
+    NB_ASSERT(scheduler != nullptr, "Poller::wait() called outside any scheduler thread");
+
+    WaitResult result = WaitResult::READY;
+    uint64_t deadline = timeout_ms ? util::NowMs() + timeout_ms : 0;
+    // 看门狗按 wait 的调用者统计运行片段
+    const void* site = __builtin_return_address(0);
+    // 注册在协程上下文保存之后进行，事件即使立刻到达也不会恢复一个尚未让出完毕的协程
+    scheduler::Scheduler::park([&](const coroutine::Coroutine::ptr& co) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (cancelled_) {
+            result = WaitResult::CANCELLED;
+            scheduler->schedule(co);
+            return;
+        }
+
+        epoll_event ev = {};
+        ev.events = events | EPOLLONESHOT;
+        ev.data.fd = fd;
+        if (::epoll_ctl(epfd_, EPOLL_CTL_MOD, fd, &ev) < 0 &&
+            (errno != ENOENT || ::epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) < 0)) {
+            // 无法注册时立即恢复，由调用者重试 I/O 并得到真实的错误
+            NB_LOG_ERROR("epoll_ctl({}) failed: {}", fd, strerror(errno));
+            scheduler->schedule(co);
+            return;
+        }
+        waiters_[fd] = Waiter{co, scheduler, deadline, &result};
+    }, site);
+    return result;
+}
+
+void Poller::cancelAll()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    cancelled_ = true;
+    while (!waiters_.empty()) {
+        wake_locked(waiters_.begin(), WaitResult::CANCELLED);
+    }
+}
+
+void Poller::wake_locked(std::unordered_map<int, Waiter>::iterator it, WaitResult result)
+{
+    Waiter waiter = std::move(it->second);
+    waiters_.erase(it);
+    *waiter.result = result;
+    waiter.scheduler->schedule(waiter.co);
+}
+
+void Poller::loop()
+{
+    epoll_event events[kMaxEvents];
+    uint64_t next_tick = util::NowMs() + kTickMs;
+    while (!stop_) {
+        int n = ::epoll_wait(epfd_, events, kMaxEvents, kTickMs);
+        if (n < 0 && errno != EINTR) {
+            NB_LOG_ERROR("epoll_wait() failed: {}", strerror(errno));
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (int i = 0; i < n; ++i) {
+            auto it = waiters_.find(events[i].data.fd);
+            if (it != waiters_.end()) {
+                wake_locked(it, WaitResult::READY);
+            }
+        }
+
+        uint64_t now = util::NowMs();
+        if (now < next_tick) {
+            continue;
+        }
+        next_tick = now + kTickMs;
+        for (auto it = waiters_.begin(); it != waiters_.end();) {
+            auto cur = it++;
+            if (cur->second.deadline != 0 && now >= cur->second.deadline) {
+                wake_locked(cur, WaitResult::TIMEOUT);
+            }
+        }
+    }
+}
+
+}
+}
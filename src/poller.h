@@ -0,0 +1,95 @@
+#ifndef NB_POLLER_H
+#define NB_POLLER_H
+
+#include "coroutine.h"
+#include "scheduler.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace nb {
+namespace io {
+
+/**
+ * @brief 基于 epoll 的 fd 就绪等待
+ * @details 协程调用 wait() 后被挂起，不再占用调度器的任务队列；后台线程通过 epoll 等待 fd 就绪，
+ *          就绪、超时或取消时将协程重新投递到挂起时所在的调度器。每个 fd 同一时刻只能有一个等待者，
+ *          fd 以 EPOLLONESHOT 方式注册，关闭 fd 时由内核自动移除。超时的精度约为 kTickMs。
+ */
+class Poller
+{
+public:
+    static constexpr int kTickMs = 100;         // 检查超时的周期
+    static constexpr int kMaxEvents = 256;      // 单次 epoll_wait 最多取回的事件数
+
+    enum class WaitResult {
+        READY = 0,          // fd 就绪（可能是虚假唤醒，调用者应重试 I/O）
+        TIMEOUT,            // 超时
+        CANCELLED           // 被 cancelAll() 取消
+    };
+
+public:
+    /**
+     * @brief 构造函数，创建 epoll 实例并启动后台线程
+     */
+    Poller();
+
+    /**
+     * @brief 析构函数，取消所有等待者并停止后台线程
+     */
+    ~Poller();
+
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+
+    /**
+     * @brief 挂起当前协程，直到 fd 就绪、超时或被取消
+     * @param fd 非阻塞 fd
+     * @param events EPOLLIN 或 EPOLLOUT；为 0 时只等待超时或取消（EPOLLERR/EPOLLHUP 仍会唤醒），可用于定时退避
+     * @param timeout_ms 超时时间，0 表示不超时
+     */
+    WaitResult wait(int fd, uint32_t events, uint64_t timeout_ms);
+
+    /**
+     * @brief 唤醒所有等待者，此后的 wait() 立即返回 CANCELLED
+     */
+    void cancelAll();
+
+private:
+    /**
+     * @brief 一个挂起的协程
+     */
+    struct Waiter
+    {
+        coroutine::Coroutine::ptr co;
+        scheduler::Scheduler* scheduler = nullptr;  // 挂起时所在的调度器
+        uint64_t deadline = 0;                      // 0 表示不超时
+        WaitResult* result = nullptr;               // 指向协程栈上的结果
+    };
+
+    /**
+     * @brief 后台线程，等待 epoll 事件并处理超时
+     */
+    void loop();
+
+    /**
+     * @brief 记录结果并重新调度等待者（需持有锁）
+     */
+    void wake_locked(std::unordered_map<int, Waiter>::iterator it, WaitResult result);
+
+private:
+    int epfd_ = -1;                                 // epoll 实例
+    std::thread thread_;                            // 后台线程
+    std::mutex mtx_;                                // 保护 waiters_ 与 cancelled_
+    std::unordered_map<int, Waiter> waiters_;       // 按 fd 索引的等待者
+    bool cancelled_ = false;                        // 是否已取消
+    std::atomic<bool> stop_ {false};                // 后台线程是否退出
+};
+
+}
+}
+
+#endif // NB_POLLER_H
@@ -2,11 +2,17 @@
 #include "log.h"
 #include "util.h"
 #include "coroutine.h"
+#include "watchdog.h"
+#include "trace.h"
 
 namespace nb {
 namespace scheduler {
 
 static thread_local coroutine::Coroutine::ptr main_co;          //!  当前线程的主协程
+static thread_local Scheduler* t_scheduler = nullptr;           //!  当前线程所属的调度器
+static thread_local Scheduler* t_switch_target = nullptr;       //!  让出的协程需要迁移到的调度器
+static thread_local const std::function<void(const coroutine::Coroutine::ptr&)>* t_park_hook = nullptr;  //!  挂起回调
+static constexpr int kIdleWaitMs = 10;                          //!  空闲线程单次等待新任务的时长
 
 Scheduler::Scheduler(int thread_num, const std::string name)
     : thread_num_(thread_num)
@@ -19,7 +25,7 @@ Scheduler::Scheduler(int thread_num, const std::string name)
 
 Scheduler::~Scheduler()
 {
-    main_co = nullptr;
+    stop();
 }
 
 bool Scheduler::schedule_nonblock(Task task)
@@ -31,6 +37,27 @@ bool Scheduler::schedule_nonblock(Task task)
     return need_tickle;
 }
 
+bool Scheduler::try_schedule(const coroutine::Coroutine::ptr& co)
+{
+    bool need_tickle = false;
+    int waiters = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (is_stop_) {
+            return false;
+        }
+        need_tickle = schedule_nonblock(Task(co));
+        waiters = idle_waiters_;
+    }
+    if (waiters > 0) {
+        cv_.notify_one();
+    }
+    if (need_tickle) {
+        tickle();
+    }
+    return true;
+}
+
 void Scheduler::start() {
     threads_pool_.reserve(thread_num_);
     for (int i = 0; i < thread_num_; ++i) {
@@ -41,13 +68,18 @@ void Scheduler::start() {
 
 void Scheduler::stop()
 {
-    NB_LOG_INFO("Stopping scheduler");
-
     if (is_stop_) {
         return;
     }
 
-    is_stop_ = true;
+    NB_LOG_INFO("Stopping scheduler");
+
+    {
+        // 与 try_schedule() 和空闲线程的退出判断互斥，停止之前入队的任务一定会被执行
+        std::lock_guard<std::mutex> lock(mtx_);
+        is_stop_ = true;
+    }
+    cv_.notify_all();
     
     std::vector<std::thread> cos;
     {
@@ -65,11 +97,14 @@ void Scheduler::stop()
 
 void Scheduler::run()
 {
+    t_scheduler = this;
     main_co = std::make_shared<coroutine::Coroutine>();
 
     coroutine::Coroutine::ptr idle_co_ = 
                         std::make_shared<coroutine::Coroutine>(std::bind(&Scheduler::idle, this));
     coroutine::Coroutine::ptr cb_co_;
+    trace::Tracer& tracer = trace::Tracer::GetInstance();
+    bool idle = false;
     Task task;
     while(true)
     {
@@ -88,20 +123,13 @@ void Scheduler::run()
             }
         }
         if (task.co_ || task.cb_) {
+            idle = false;
             if (task.co_) {
-                task.co_->Resume();
-                if (task.co_->getState() == coroutine::Coroutine::State::READY) {
-                    std::lock_guard<std::mutex> lock(mtx_);
-                    task_queue_.push_back(task);
-                }
+                resume(task.co_);
                 task.co_ = nullptr;
             } else if (task.cb_) {
                 cb_co_.reset(new coroutine::Coroutine(task.cb_));
-                cb_co_->Resume();
-                if (cb_co_->getState() == coroutine::Coroutine::State::READY) {
-                    std::lock_guard<std::mutex> lock(mtx_);
-                    task_queue_.push_back(Task(cb_co_));
-                }
+                resume(cb_co_);
                 task.cb_ = nullptr;
             } 
         } else {
@@ -109,15 +137,84 @@ void Scheduler::run()
                 NB_LOG_INFO("Idle coroutine finished, exiting thread");
                 break;
             }
+            if (!idle) {
+                // 空闲协程会反复让出，只记录由忙转闲的那一次
+                idle = true;
+                tracer.record(trace::EventType::IDLE_PARK);
+            }
             idle_co_->Resume();
         }
     }
+
+    cb_co_ = nullptr;
+    idle_co_ = nullptr;
+    main_co = nullptr;
+    t_scheduler = nullptr;
+}
+
+void Scheduler::resume(const coroutine::Coroutine::ptr& co)
+{
+    watchdog::Watchdog& watchdog = watchdog::Watchdog::GetInstance();
+    trace::Tracer& tracer = trace::Tracer::GetInstance();
+
+    if (co->getThreadId() != 0 && co->getThreadId() != util::GetThreadId()) {
+        tracer.record(trace::EventType::STEAL, co->getId());
+    }
+    tracer.record(trace::EventType::RESUME, co->getId());
+    watchdog.onSliceBegin(co.get());
+
+    co->Resume();
+
+    watchdog.onSliceEnd();
+    tracer.record(co->getState() == coroutine::Coroutine::State::READY ?
+                  trace::EventType::YIELD : trace::EventType::FINISH, co->getId());
+    requeue(co);
+}
+
+void Scheduler::requeue(const coroutine::Coroutine::ptr& co)
+{
+    // 必须在协程切回主协程之后再投递，否则目标线程可能恢复一个上下文尚未保存完毕的协程
+    Scheduler* target = t_switch_target;
+    t_switch_target = nullptr;
+    const auto* park_hook = t_park_hook;
+    t_park_hook = nullptr;
+
+    if (co->getState() != coroutine::Coroutine::State::READY) {
+        return;
+    }
+
+    if (park_hook) {
+        (*park_hook)(co);
+        return;
+    }
+
+    if (target && target != this) {
+        if (target->try_schedule(co)) {
+            return;
+        }
+        // 切换请求之后目标才被停止，留在当前调度器上继续运行，避免协程永远无法恢复
+        NB_LOG_ERROR("switch_to() target scheduler {} has stopped, coroutine {} stays on {}",
+                     target->name_, co->getId(), name_);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    task_queue_.push_back(Task(co));
 }
 
 void Scheduler::idle()
 {
-    while(!is_stop_ || !task_queue_.empty()) {
-        // NB_LOG_INFO("enter idle !!!");
+    while (true) {
+        {
+            // 没有任务时阻塞等待，避免工作线程空转；每个新任务入队时唤醒一个等待的线程
+            std::unique_lock<std::mutex> lock(mtx_);
+            if (is_stop_ && task_queue_.empty()) {
+                break;
+            }
+            ++idle_waiters_;
+            cv_.wait_for(lock, std::chrono::milliseconds(kIdleWaitMs),
+                         [this]() { return is_stop_ || !task_queue_.empty(); });
+            --idle_waiters_;
+        }
         coroutine::Coroutine::Yield();
     }
     
@@ -125,6 +222,7 @@ void Scheduler::idle()
 
 void Scheduler::tickle()
 {
+    trace::Tracer::GetInstance().record(trace::EventType::WAKE);
     NB_LOG_INFO("tickle");
 }
 
@@ -132,5 +230,40 @@ coroutine::Coroutine::ptr& Scheduler::GetMainContext() {
     return main_co;
 }
 
+Scheduler* Scheduler::GetThis()
+{
+    return t_scheduler;
+}
+
+bool Scheduler::switch_to(Scheduler& target)
+{
+    NB_ASSERT(t_scheduler != nullptr, "switch_to() called outside any scheduler thread");
+    NB_ASSERT(coroutine::Coroutine::GetThis() != nullptr, "switch_to() called outside any coroutine");
+
+    if (t_scheduler == &target) {
+        return true;
+    }
+    if (target.is_stop_) {
+        NB_LOG_ERROR("switch_to() target scheduler {} has stopped, stays on {}", target.name_, t_scheduler->name_);
+        return false;
+    }
+
+    t_switch_target = &target;
+    // 让出位置记为调用者，迁移后的运行片段按真正的调用点统计
+    coroutine::Coroutine::Yield(__builtin_return_address(0));
+    // 让出之后目标才停止时，requeue 会把协程留在原调度器上
+    return t_scheduler == &target;
+}
+
+void Scheduler::park(const std::function<void(const coroutine::Coroutine::ptr&)>& on_parked,
+                     const void* site)
+{
+    NB_ASSERT(t_scheduler != nullptr, "park() called outside any scheduler thread");
+    NB_ASSERT(coroutine::Coroutine::GetThis() != nullptr, "park() called outside any coroutine");
+
+    t_park_hook = &on_parked;
+    coroutine::Coroutine::Yield(site ? site : __builtin_return_address(0));
+}
+
 }
 }
\ No newline at end of file
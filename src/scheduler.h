@@ -3,6 +3,9 @@
 
 #include "coroutine.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -55,10 +58,15 @@ public:
     void schedule(T t)
     {
         bool need_tickle = false;
+        int waiters = 0;
         Task task(t);
         {
             std::lock_guard<std::mutex> lock(mtx_);
             need_tickle = schedule_nonblock(task);
+            waiters = idle_waiters_;
+        }
+        if (waiters > 0) {
+            cv_.notify_one();
         }
         if (need_tickle) {
             tickle();
@@ -74,11 +82,24 @@ public:
     void schedule_more(const Container& tasks) 
     {
         bool need_tickle = false;
+        int waiters = 0;
+        int count = 0;
         {
+            std::lock_guard<std::mutex> lock(mtx_);
             for (typename Container::const_iterator it = tasks.begin();
                  it != tasks.end(); ++it) 
             {
-                need_tickle = schedule_nonblock(*it);
+                need_tickle = schedule_nonblock(*it) || need_tickle;
+                ++count;
+            }
+            waiters = idle_waiters_;
+        }
+        // 每个新任务唤醒一个空闲线程，使一批任务并行开始
+        if (count >= waiters) {
+            cv_.notify_all();
+        } else {
+            for (int i = 0; i < count; ++i) {
+                cv_.notify_one();
             }
         }
         if (need_tickle) {
@@ -102,6 +123,44 @@ public:
      */
     static coroutine::Coroutine::ptr& GetMainContext();
 
+    /**
+     * @brief 获取当前线程所属的调度器
+     * @return 调度器指针，非调度线程返回 nullptr
+     */
+    static Scheduler* GetThis();
+
+    /**
+     * @brief 将当前协程迁移到另一个调度器上继续执行
+     * @details 当前协程让出执行权，由原线程在切回主协程后将其投递到 target 的任务队列，
+     *          之后在 target 的某个工作线程上恢复。target 为当前调度器时直接返回。
+     *          target 已停止时记录错误并留在当前调度器上继续执行。target 的生命周期必须长于
+     *          所有可能迁移到它的协程。
+     * @param target 目标调度器
+     * @return 协程当前是否运行在 target 上
+     */
+    static bool switch_to(Scheduler& target);
+
+    /**
+     * @brief 挂起当前协程，让出后不再自动重新入队
+     * @details 协程切回主协程后，在原线程上以该协程为参数调用 on_parked，由调用者保存协程，
+     *          并在条件满足时通过 schedule() 重新调度。回调在协程上下文保存完毕之后才执行，
+     *          因此其他线程此时恢复该协程是安全的。
+     * @param on_parked 挂起完成后的回调
+     * @param site 记录给看门狗的让出位置，为空时使用 park 调用者的返回地址
+     */
+    static void park(const std::function<void(const coroutine::Coroutine::ptr&)>& on_parked,
+                     const void* site = nullptr);
+
+    /**
+     * @brief 获取调度器名称
+     */
+    const std::string& getName() const { return name_; }
+
+    /**
+     * @brief 获取工作线程数量
+     */
+    int getThreadNum() const { return thread_num_; }
+
 private:
     /**
      * @brief 非阻塞方式调度一个任务
@@ -110,6 +169,13 @@ private:
      */
     bool schedule_nonblock(Task task);
 
+    /**
+     * @brief 调度器未停止时调度一个协程，停止检查与入队在同一次加锁内完成
+     * @param co 协程对象
+     * @return 调度器已停止时返回 false，协程不会入队
+     */
+    bool try_schedule(const coroutine::Coroutine::ptr& co);
+
     /**
      * @brief 唤醒调度器的一个线程，通知有新任务到来
      */
@@ -120,6 +186,19 @@ private:
      */
     void run();
 
+    /**
+     * @brief 在当前线程上运行协程的一个片段，并完成观测记录与重新入队
+     * @param co 待恢复的协程
+     */
+    void resume(const coroutine::Coroutine::ptr& co);
+
+    /**
+     * @brief 协程切回主协程后，将仍处于 READY 状态的协程重新入队
+     * @details 若协程通过 switch_to 请求迁移，则投递到目标调度器
+     * @param co 刚刚让出的协程
+     */
+    void requeue(const coroutine::Coroutine::ptr& co);
+
     /**
      * @brief 空闲协程函数，当没有任务可执行时运行
      */
@@ -129,8 +208,10 @@ private:
     std::list<Task> task_queue_;                // 任务队列
     std::vector<std::thread> threads_pool_;     // 线程池
     std::mutex mtx_;                            // 互斥锁保护任务队列
+    std::condition_variable cv_;                // 空闲线程等待新任务
+    int idle_waiters_ = 0;                      // 正在 cv_ 上等待的空闲线程数，受 mtx_ 保护
     int thread_num_;                            // 线程数量
-    bool is_stop_;                              // 调度器是否停止
+    std::atomic<bool> is_stop_;                 // 调度器是否停止
     const std::string name_;                    // 调度器名称
 };
 
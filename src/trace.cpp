@@ -0,0 +1,203 @@
+#include "trace.h"
+#include "log.h"
+#include "util.h"
+#include "scheduler.h"
+
+#include <fstream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace nb {
+namespace trace {
+
+static thread_local void* t_buffer = nullptr;       //!  当前线程的事件缓冲区
+
+static const char* EventName(EventType type)
+{
+    switch (type) {
+        case EventType::CREATE:    return "create";
+        case EventType::RESUME:    return "resume";
+        case EventType::YIELD:     return "yield";
+        case EventType::FINISH:    return "finish";
+        case EventType::STEAL:     return "steal";
+        case EventType::IDLE_PARK: return "idle";
+        case EventType::WAKE:      return "wake";
+        default:                   return "unknown";
+    }
+}
+
+Tracer& Tracer::GetInstance()
+{
+    static Tracer instance;
+    return instance;
+}
+
+uint64_t Tracer::ReadTsc()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return util::NowNs();
+#endif
+}
+
+void Tracer::enable(size_t events_per_thread)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    events_per_thread_ = events_per_thread;
+    base_ns_ = util::NowNs();
+    base_tsc_ = ReadTsc();
+    generation_.fetch_add(1, std::memory_order_release);
+    enabled_ = true;
+}
+
+void Tracer::disable()
+{
+    enabled_ = false;
+}
+
+Tracer::ThreadBuffer* Tracer::getBuffer()
+{
+    if (t_buffer) {
+        return static_cast<ThreadBuffer*>(t_buffer);
+    }
+
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->tid = util::GetThreadId();
+    scheduler::Scheduler* scheduler = scheduler::Scheduler::GetThis();
+    buffer->name = scheduler ? scheduler->getName() : fmt::format("thread {}", buffer->tid);
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        buffer->capacity = events_per_thread_;
+        buffers_.push_back(buffer);
+    }
+    buffer->events.reset(new Event[buffer->capacity]);
+    t_buffer = buffer.get();
+    return buffer.get();
+}
+
+void Tracer::append(EventType type, uint64_t fiber_id)
+{
+    ThreadBuffer* buffer = getBuffer();
+
+    // 新一轮追踪开始后由写者自己清空缓冲区，避免与读者竞争
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        buffer->size.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+
+    size_t size = buffer->size.load(std::memory_order_relaxed);
+    if (size >= buffer->capacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[size] = Event{ReadTsc(), fiber_id, type};
+    buffer->size.store(size + 1, std::memory_order_release);
+}
+
+std::string Tracer::toJson()
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint64_t base_tsc, base_ns;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        buffers = buffers_;
+        base_tsc = base_tsc_;
+        base_ns = base_ns_;
+    }
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+
+    // 用本轮开始至今的 TSC 增量与纳秒增量换算 TSC 频率
+    uint64_t elapsed_ns = util::NowNs() - base_ns;
+    uint64_t elapsed_tsc = ReadTsc() - base_tsc;
+    double ticks_per_us = elapsed_ns ? elapsed_tsc * 1000.0 / elapsed_ns : 1000.0;
+    auto to_us = [&](uint64_t tsc) {
+        return tsc > base_tsc ? (tsc - base_tsc) / ticks_per_us : 0.0;
+    };
+
+    pid_t pid = getpid();
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto emit = [&](const std::string& event) {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+        json += event;
+    };
+
+    for (auto& buffer : buffers) {
+        if (buffer->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+        size_t size = buffer->size.load(std::memory_order_acquire);
+        emit(fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+                         "\"args\":{{\"name\":\"{} ({})\",\"dropped\":{}}}}}",
+                         pid, buffer->tid, buffer->name, buffer->tid,
+                         buffer->dropped.load(std::memory_order_relaxed)));
+
+        // 运行片段与空闲区间转换为完整事件（ph=X），其余事件为瞬时事件（ph=i）
+        bool running = false;
+        uint64_t running_fiber = 0;
+        double running_ts = 0;
+        bool idle = false;
+        double idle_ts = 0;
+        for (size_t i = 0; i < size; ++i) {
+            const Event& event = buffer->events[i];
+            double ts = to_us(event.tsc);
+            switch (event.type) {
+                case EventType::RESUME:
+                    if (idle) {
+                        emit(fmt::format("{{\"name\":\"idle\",\"cat\":\"scheduler\",\"ph\":\"X\","
+                                         "\"pid\":{},\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                         pid, buffer->tid, idle_ts, ts - idle_ts));
+                        idle = false;
+                    }
+                    running = true;
+                    running_fiber = event.fiber_id;
+                    running_ts = ts;
+                    break;
+                case EventType::YIELD:
+                case EventType::FINISH:
+                    if (running && running_fiber == event.fiber_id) {
+                        emit(fmt::format("{{\"name\":\"fiber {}\",\"cat\":\"coroutine\",\"ph\":\"X\","
+                                         "\"pid\":{},\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},"
+                                         "\"args\":{{\"fid\":{},\"end\":\"{}\"}}}}",
+                                         event.fiber_id, pid, buffer->tid, running_ts, ts - running_ts,
+                                         event.fiber_id, EventName(event.type)));
+                    }
+                    running = false;
+                    break;
+                case EventType::IDLE_PARK:
+                    idle = true;
+                    idle_ts = ts;
+                    break;
+                default:
+                    emit(fmt::format("{{\"name\":\"{}\",\"cat\":\"scheduler\",\"ph\":\"i\",\"s\":\"t\","
+                                     "\"pid\":{},\"tid\":{},\"ts\":{:.3f},\"args\":{{\"fid\":{}}}}}",
+                                     EventName(event.type), pid, buffer->tid, ts, event.fiber_id));
+                    break;
+            }
+        }
+    }
+
+    json += "]}\n";
+    return json;
+}
+
+bool Tracer::dump(const std::string& path)
+{
+    std::ofstream ofs(path, std::ios::trunc);
+    if (!ofs.is_open()) {
+        NB_LOG_ERROR("Failed to open trace file: {}", path);
+        return false;
+    }
+    ofs << toJson();
+    return ofs.good();
+}
+
+}
+}
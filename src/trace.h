@@ -0,0 +1,130 @@
+#ifndef NB_TRACE_H
+#define NB_TRACE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nb {
+namespace trace {
+
+/**
+ * @brief 调度事件类型
+ */
+enum class EventType : uint8_t {
+    CREATE = 0,     // 协程创建
+    RESUME,         // 协程开始一次运行
+    YIELD,          // 协程让出
+    FINISH,         // 协程结束（含异常结束）
+    STEAL,          // 协程在与上次不同的线程上恢复
+    IDLE_PARK,      // 工作线程进入空闲
+    WAKE            // 调度器唤醒工作线程
+};
+
+/**
+ * @brief 调度事件追踪器，可导出 Chrome trace / Perfetto 可读的 JSON 时间线
+ * @details 每个线程写入各自的定长缓冲区，单写者无锁追加，缓冲区写满后丢弃新事件。
+ *          时间戳取自 TSC（非 x86 平台退化为 steady_clock），导出时换算为微秒。
+ *          导出应在 disable() 之后进行，以获得一致的快照。
+ */
+class Tracer
+{
+public:
+    /**
+     * @brief 单条事件，保持紧凑以减少写入开销
+     */
+    struct Event
+    {
+        uint64_t tsc;           // 时间戳
+        uint64_t fiber_id;      // 协程 ID，与协程无关的事件为 0
+        EventType type;         // 事件类型
+    };
+
+public:
+    static Tracer& GetInstance();
+
+    /**
+     * @brief 开启一次新的追踪，之前记录的事件被丢弃
+     * @param events_per_thread 每个线程缓冲区可容纳的事件数，仅对新登记的线程生效
+     */
+    void enable(size_t events_per_thread = 1 << 16);
+
+    /**
+     * @brief 停止记录事件
+     */
+    void disable();
+
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 记录一条事件，未开启追踪时只有一次原子读的开销
+     * @param type 事件类型
+     * @param fiber_id 协程 ID
+     */
+    void record(EventType type, uint64_t fiber_id = 0)
+    {
+        if (isEnabled()) {
+            append(type, fiber_id);
+        }
+    }
+
+    /**
+     * @brief 将本次追踪的事件转换为 Chrome trace JSON
+     */
+    std::string toJson();
+
+    /**
+     * @brief 将 Chrome trace JSON 写入文件，可直接用 chrome://tracing 或 ui.perfetto.dev 打开
+     * @param path 文件路径
+     * @return 写入是否成功
+     */
+    bool dump(const std::string& path);
+
+private:
+    /**
+     * @brief 线程私有的事件缓冲区
+     */
+    struct ThreadBuffer
+    {
+        uint64_t tid = 0;                           // 线程 ID
+        std::string name;                           // 线程名称（所属调度器）
+        std::unique_ptr<Event[]> events;            // 事件数组
+        size_t capacity = 0;                        // 容量
+        std::atomic<size_t> size {0};               // 已写入事件数，写者 release，读者 acquire
+        std::atomic<uint64_t> generation {0};       // 所属的追踪轮次
+        std::atomic<uint64_t> dropped {0};          // 因写满丢弃的事件数
+    };
+
+    Tracer() = default;
+
+    /**
+     * @brief 追加事件到当前线程的缓冲区
+     */
+    void append(EventType type, uint64_t fiber_id);
+
+    /**
+     * @brief 获取当前线程的缓冲区，不存在时创建并登记
+     */
+    ThreadBuffer* getBuffer();
+
+    /**
+     * @brief 读取时间戳计数器
+     */
+    static uint64_t ReadTsc();
+
+private:
+    std::atomic<bool> enabled_ {false};                     // 是否正在记录
+    std::atomic<uint64_t> generation_ {0};                  // 追踪轮次，enable 时递增
+    size_t events_per_thread_ = 1 << 16;                    // 新缓冲区容量
+    uint64_t base_tsc_ = 0;                                 // 本轮开始时的 TSC
+    uint64_t base_ns_ = 0;                                  // 本轮开始时的 steady_clock 纳秒数
+    std::mutex mtx_;                                        // 保护缓冲区列表
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;    // 所有线程的缓冲区
+};
+
+}
+}
+
+#endif // NB_TRACE_H
@@ -1,8 +1,12 @@
 #ifndef NB_UTIL_H
 #define NB_UTIL_H
 
+#include <strings.h>
 #include <sys/syscall.h>
 #include <unistd.h>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
 
 // util.h
 #define NB_ASSERT(cond, msg) \
@@ -22,7 +26,38 @@ namespace util {
 
 inline uint64_t GetThreadId()
 {
-    return static_cast<uint64_t>(::syscall(SYS_gettid));
+    // 线程 ID 在线程生命周期内不变，缓存以避免每次都陷入内核
+    static thread_local uint64_t tid = static_cast<uint64_t>(::syscall(SYS_gettid));
+    return tid;
+}
+
+/**
+ * @brief 单调时钟的当前时间，用于计算耗时与超时
+ */
+inline uint64_t NowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline uint64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline uint64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 忽略 ASCII 大小写比较两个字符串
+ */
+inline bool EqualsIgnoreCase(std::string_view a, std::string_view b)
+{
+    return a.size() == b.size() && strncasecmp(a.data(), b.data(), a.size()) == 0;
 }
 
 
@@ -0,0 +1,297 @@
+#include "watchdog.h"
+#include "log.h"
+#include "util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cxxabi.h>
+#include <execinfo.h>
+
+namespace nb {
+namespace watchdog {
+
+// 与 Go 运行时的抢占信号相同，默认动作为忽略，未安装处理函数时误投递也不会终止进程
+static constexpr int kStackSignal = SIGURG;
+
+/**
+ * @brief 线程退出时将槽位标记为失效，保留其直方图数据
+ */
+struct SlotHolder
+{
+    std::shared_ptr<void> slot_owner;
+    std::atomic<bool>* alive = nullptr;
+    std::atomic<uint64_t>* fiber_id = nullptr;
+
+    ~SlotHolder()
+    {
+        if (alive) {
+            fiber_id->store(0, std::memory_order_relaxed);
+            alive->store(false, std::memory_order_release);
+        }
+    }
+};
+
+static thread_local void* t_slot = nullptr;             //!  当前线程的槽位
+static thread_local SlotHolder t_slot_holder;           //!  负责线程退出时注销槽位
+
+static int BucketIndex(uint64_t us)
+{
+    int index = 0;
+    while (us > 1 && index < Watchdog::kBucketNum - 1) {
+        us >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+static std::string Demangle(const char* name)
+{
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status != 0 || demangled == nullptr) {
+        return name;
+    }
+    std::string result(demangled);
+    free(demangled);
+    return result;
+}
+
+static std::string Symbolize(const void* addr)
+{
+    void* frame = const_cast<void*>(addr);
+    char** symbols = backtrace_symbols(&frame, 1);
+    if (symbols == nullptr) {
+        return fmt::format("{}", addr);
+    }
+    std::string result(symbols[0]);
+    free(symbols);
+    return result;
+}
+
+Watchdog& Watchdog::GetInstance()
+{
+    static Watchdog instance;
+    return instance;
+}
+
+Watchdog::~Watchdog()
+{
+    stop();
+}
+
+void Watchdog::start(uint64_t threshold_ms, uint64_t interval_ms)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (running_) {
+        return;
+    }
+
+    // 预先调用一次 backtrace，确保 libgcc 已加载，信号处理函数中不再触发动态加载
+    void* warmup[1];
+    backtrace(warmup, 1);
+
+    struct sigaction sa = {};
+    sa.sa_handler = &Watchdog::StackSignalHandler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(kStackSignal, &sa, nullptr);
+
+    threshold_us_ = threshold_ms * 1000;
+    interval_ms_ = interval_ms;
+    running_ = true;
+    watch_thread_ = std::thread(&Watchdog::watch_loop, this);
+    NB_LOG_INFO("Watchdog started, threshold {} ms, interval {} ms", threshold_ms, interval_ms);
+}
+
+void Watchdog::stop()
+{
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        thread.swap(watch_thread_);
+    }
+    cond_v_.notify_all();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+Watchdog::WorkerSlot* Watchdog::getSlot()
+{
+    if (t_slot) {
+        return static_cast<WorkerSlot*>(t_slot);
+    }
+
+    auto slot = std::make_shared<WorkerSlot>();
+    slot->tid = static_cast<pid_t>(util::GetThreadId());
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        slots_.push_back(slot);
+    }
+    t_slot_holder.slot_owner = slot;
+    t_slot_holder.alive = &slot->alive;
+    t_slot_holder.fiber_id = &slot->fiber_id;
+    t_slot = slot.get();
+    return slot.get();
+}
+
+void Watchdog::beginSlice(coroutine::Coroutine* co)
+{
+    WorkerSlot* slot = getSlot();
+    if (co->getYieldSite()) {
+        slot->site = SiteKey{co->getYieldSite(), nullptr};
+    } else {
+        slot->site = SiteKey{nullptr, &co->getEntryType()};
+    }
+    slot->slice_start_us.store(util::NowUs(), std::memory_order_relaxed);
+    slot->fiber_id.store(co->getId(), std::memory_order_release);
+}
+
+void Watchdog::onSliceEnd()
+{
+    WorkerSlot* slot = static_cast<WorkerSlot*>(t_slot);
+    if (slot == nullptr || slot->fiber_id.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    uint64_t duration = util::NowUs() - slot->slice_start_us.load(std::memory_order_relaxed);
+    slot->fiber_id.store(0, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(slot->hist_mtx);
+    SliceStat& stat = slot->hist[slot->site];
+    stat.count++;
+    stat.total_us += duration;
+    stat.max_us = std::max(stat.max_us, duration);
+    stat.buckets[BucketIndex(duration)]++;
+}
+
+void Watchdog::StackSignalHandler(int /*sig*/)
+{
+    WorkerSlot* slot = static_cast<WorkerSlot*>(t_slot);
+    if (slot == nullptr) {
+        return;
+    }
+    int saved_errno = errno;
+    int n = backtrace(slot->frames, kMaxFrames);
+    slot->frame_num.store(n, std::memory_order_release);
+    errno = saved_errno;
+}
+
+void Watchdog::watch_loop()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (running_) {
+        cond_v_.wait_for(lock, std::chrono::milliseconds(interval_ms_));
+        if (!running_) {
+            break;
+        }
+
+        std::vector<std::shared_ptr<WorkerSlot>> slots = slots_;
+        lock.unlock();
+        uint64_t now = util::NowUs();
+        for (auto& slot : slots) {
+            check(slot.get(), now);
+        }
+        lock.lock();
+    }
+}
+
+void Watchdog::check(WorkerSlot* slot, uint64_t now_us)
+{
+    if (!slot->alive.load(std::memory_order_acquire)) {
+        return;
+    }
+    uint64_t fiber_id = slot->fiber_id.load(std::memory_order_acquire);
+    uint64_t start = slot->slice_start_us.load(std::memory_order_relaxed);
+    if (fiber_id == 0 || now_us < start || now_us - start < threshold_us_ ||
+        slot->reported_start_us == start) {
+        return;
+    }
+    slot->reported_start_us = start;
+
+    // 向工作线程发送信号，由其在信号处理函数中抓取自身调用栈
+    slot->frame_num.store(-1, std::memory_order_relaxed);
+    int frame_num = -1;
+    if (::syscall(SYS_tgkill, getpid(), slot->tid, kStackSignal) == 0) {
+        for (int i = 0; i < 50 && frame_num < 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            frame_num = slot->frame_num.load(std::memory_order_acquire);
+        }
+    }
+
+    bool same_slice = slot->fiber_id.load(std::memory_order_acquire) == fiber_id &&
+                      slot->slice_start_us.load(std::memory_order_relaxed) == start;
+
+    std::string stack;
+    if (frame_num > 0 && same_slice) {
+        char** symbols = backtrace_symbols(slot->frames, frame_num);
+        for (int i = 0; i < frame_num; ++i) {
+            stack += fmt::format("\n    #{} {}", i, symbols ? symbols[i] : "");
+        }
+        free(symbols);
+    } else {
+        stack = "\n    <slice ended before the stack was captured>";
+    }
+
+    NB_LOG_WARN("Coroutine {} on thread {} has run for {} ms without yielding{}",
+                fiber_id, slot->tid, (now_us - start) / 1000, stack);
+}
+
+std::string Watchdog::report()
+{
+    std::unordered_map<SiteKey, SliceStat, SiteKeyHash> merged;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (auto& slot : slots_) {
+            std::lock_guard<std::mutex> hist_lock(slot->hist_mtx);
+            for (auto& item : slot->hist) {
+                SliceStat& stat = merged[item.first];
+                stat.count += item.second.count;
+                stat.total_us += item.second.total_us;
+                stat.max_us = std::max(stat.max_us, item.second.max_us);
+                for (int i = 0; i < kBucketNum; ++i) {
+                    stat.buckets[i] += item.second.buckets[i];
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<SiteKey, SliceStat>> sorted(merged.begin(), merged.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.max_us > b.second.max_us;
+    });
+
+    std::string result = "Coroutine run-slice histogram (us):";
+    for (auto& item : sorted) {
+        const SiteKey& key = item.first;
+        const SliceStat& stat = item.second;
+        std::string site = key.entry ? "entry " + Demangle(key.entry->name())
+                                     : "after yield at " + Symbolize(key.site);
+        result += fmt::format("\n  {}\n    count={} avg={} max={}\n   ",
+                              site, stat.count, stat.total_us / stat.count, stat.max_us);
+        for (int i = 0; i < kBucketNum; ++i) {
+            if (stat.buckets[i]) {
+                result += fmt::format(" [{},{}):{}", i == 0 ? 0 : (1ull << i), 1ull << (i + 1), stat.buckets[i]);
+            }
+        }
+    }
+    return result;
+}
+
+void Watchdog::reset()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto& slot : slots_) {
+        std::lock_guard<std::mutex> hist_lock(slot->hist_mtx);
+        slot->hist.clear();
+    }
+}
+
+}
+}
@@ -0,0 +1,169 @@
+#ifndef NB_WATCHDOG_H
+#define NB_WATCHDOG_H
+
+#include "coroutine.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace nb {
+namespace watchdog {
+
+/**
+ * @brief 协程看门狗，检测长时间不让出的协程并统计运行片段耗时
+ * @details 调度是协作式的，一个不让出的协程会独占工作线程。看门狗线程定期采样
+ *          每个工作线程当前运行的协程及片段开始时间，超过阈值时通过信号抓取该线程的
+ *          调用栈并输出告警；同时按调用点统计每次运行片段耗时的直方图。
+ */
+class Watchdog
+{
+public:
+    static constexpr int kBucketNum = 24;       // 直方图桶数，第 i 个桶覆盖 [2^i, 2^(i+1)) 微秒
+    static constexpr int kMaxFrames = 32;       // 抓取调用栈的最大深度
+
+    /**
+     * @brief 单个调用点的运行片段统计
+     */
+    struct SliceStat
+    {
+        uint64_t count = 0;                     // 片段数量
+        uint64_t total_us = 0;                  // 总耗时
+        uint64_t max_us = 0;                    // 最大耗时
+        uint64_t buckets[kBucketNum] = {0};     // 耗时分布
+    };
+
+public:
+    static Watchdog& GetInstance();
+
+    ~Watchdog();
+
+    /**
+     * @brief 启动看门狗线程
+     * @param threshold_ms 运行片段超过该时长即告警
+     * @param interval_ms 采样间隔
+     */
+    void start(uint64_t threshold_ms = 100, uint64_t interval_ms = 10);
+
+    /**
+     * @brief 停止看门狗线程
+     */
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 调度器在恢复协程前调用，记录运行片段的开始
+     * @param co 即将恢复的协程
+     */
+    void onSliceBegin(coroutine::Coroutine* co)
+    {
+        if (isRunning()) {
+            beginSlice(co);
+        }
+    }
+
+    /**
+     * @brief 调度器在协程切回后调用，记录运行片段的结束
+     */
+    void onSliceEnd();
+
+    /**
+     * @brief 生成按调用点汇总的运行片段直方图报告
+     * @return 报告文本，按最大耗时降序排列
+     */
+    std::string report();
+
+    /**
+     * @brief 清空已统计的直方图
+     */
+    void reset();
+
+private:
+    /**
+     * @brief 调用点，入口片段用入口函数类型标识，其余用上一次让出的位置标识
+     */
+    struct SiteKey
+    {
+        const void* site;
+        const std::type_info* entry;
+
+        bool operator==(const SiteKey& other) const
+        {
+            return site == other.site && entry == other.entry;
+        }
+    };
+
+    struct SiteKeyHash
+    {
+        size_t operator()(const SiteKey& key) const
+        {
+            return std::hash<const void*>()(key.site) ^ (std::hash<const void*>()(key.entry) << 1);
+        }
+    };
+
+    /**
+     * @brief 每个工作线程的采样槽位
+     */
+    struct WorkerSlot
+    {
+        pid_t tid = 0;                                  // 工作线程 ID
+        std::atomic<bool> alive {true};                 // 线程是否仍在运行
+        std::atomic<uint64_t> fiber_id {0};             // 当前运行的协程 ID，0 表示没有
+        std::atomic<uint64_t> slice_start_us {0};       // 当前片段开始时间
+        SiteKey site {nullptr, nullptr};                // 当前片段的调用点，仅工作线程访问
+        uint64_t reported_start_us = 0;                 // 已告警片段的开始时间，仅看门狗线程访问
+
+        std::atomic<int> frame_num {-1};                // 信号处理函数抓取到的栈深度
+        void* frames[kMaxFrames];                       // 抓取到的调用栈
+
+        std::mutex hist_mtx;                            // 保护直方图
+        std::unordered_map<SiteKey, SliceStat, SiteKeyHash> hist;   // 按调用点的直方图
+    };
+
+    Watchdog() = default;
+
+    /**
+     * @brief 记录运行片段开始，首次调用时注册当前线程的槽位
+     */
+    void beginSlice(coroutine::Coroutine* co);
+
+    /**
+     * @brief 获取当前线程的槽位，不存在时创建
+     */
+    WorkerSlot* getSlot();
+
+    /**
+     * @brief 看门狗线程主循环
+     */
+    void watch_loop();
+
+    /**
+     * @brief 检查一个槽位，超时则抓栈并告警
+     */
+    void check(WorkerSlot* slot, uint64_t now_us);
+
+    /**
+     * @brief 抓栈信号处理函数，在被采样的工作线程上执行
+     */
+    static void StackSignalHandler(int sig);
+
+private:
+    std::atomic<bool> running_ {false};                 // 看门狗是否运行
+    uint64_t threshold_us_ = 100 * 1000;                // 告警阈值
+    uint64_t interval_ms_ = 10;                         // 采样间隔
+    std::thread watch_thread_;                          // 看门狗线程
+    std::mutex mtx_;                                    // 保护槽位列表与启停
+    std::condition_variable cond_v_;                    // 用于及时唤醒并退出看门狗线程
+    std::vector<std::shared_ptr<WorkerSlot>> slots_;    // 所有工作线程槽位
+};
+
+}
+}
+
+#endif // NB_WATCHDOG_H